@@ -16,6 +16,7 @@
 #include <systemd/sd-daemon.h>
 
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/http/verb.hpp>
 
 #include <cstddef>
 #include <cstdint>
@@ -53,6 +54,12 @@ class App
         router.handle(req, asyncResp);
     }
 
+    bool streamsBodyToFile(boost::beast::http::verb method,
+                           std::string_view path) const
+    {
+        return router.streamsBodyToFile(method, path);
+    }
+
     DynamicRule& routeDynamic(const std::string& rule)
     {
         return router.newRuleDynamic(rule);
@@ -2,7 +2,10 @@
 // SPDX-FileCopyrightText: Copyright OpenBMC Authors
 #pragma once
 
+#include "bmcweb_config.h"
+
 #include "boost_formatters.hpp"
+#include "http_body.hpp"
 #include "http_response.hpp"
 #include "http_utility.hpp"
 #include "json_html_serializer.hpp"
@@ -13,6 +16,9 @@
 #include <nlohmann/json.hpp>
 
 #include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -20,41 +26,122 @@
 namespace crow
 {
 
-inline void completeResponseFields(std::string_view accepts, Response& res)
+// Bodies smaller than this aren't worth the cost of compressing
+constexpr size_t compressionThresholdBytes = 1024;
+
+// Applies gzip to the body as it is written, if the client accepts it
+inline void compressResponse(std::string_view acceptEncoding, Response& res)
+{
+    if constexpr (!BMCWEB_HTTP_COMPRESSION)
+    {
+        return;
+    }
+    res.addHeader(boost::beast::http::field::vary, "Accept-Encoding");
+
+    std::optional<size_t> size = res.response.body().payloadSize();
+    if (size && *size < compressionThresholdBytes)
+    {
+        return;
+    }
+
+    using http_helpers::Encoding;
+    std::array<Encoding, 2> available{Encoding::GZIP,
+                                      Encoding::UnencodedBytes};
+    if (http_helpers::getPreferredEncoding(acceptEncoding, available) !=
+        Encoding::GZIP)
+    {
+        return;
+    }
+    res.response.body().compression = bmcweb::CompressionType::Gzip;
+    res.addHeader(boost::beast::http::field::content_encoding, "gzip");
+
+    std::string_view etag = res.getHeaderValue(boost::beast::http::field::etag);
+    if (!etag.empty())
+    {
+        std::string gzipEtag = Response::gzipEtag(etag);
+        res.clearHeader(boost::beast::http::field::etag);
+        res.addHeader(boost::beast::http::field::etag, gzipEtag);
+    }
+}
+
+// canChunk is false for clients that can't take a chunked body, which rules
+// out streaming the json serialization.
+inline void completeResponseFields(std::string_view accepts,
+                                   std::string_view acceptEncoding,
+                                   bool canChunk, Response& res)
 {
     BMCWEB_LOG_INFO("Response: {}", res.resultInt());
     addSecurityHeaders(res);
 
-    res.setHashAndHandleNotModified();
-    if (res.jsonValue.is_structured())
+    if (!res.jsonValue.is_structured())
     {
-        using http_helpers::ContentType;
-        std::array<ContentType, 3> allowed{ContentType::CBOR, ContentType::JSON,
-                                           ContentType::HTML};
-        ContentType preferred = getPreferredContentType(accepts, allowed);
+        res.setHashAndHandleNotModified();
+        return;
+    }
 
-        if (preferred == ContentType::HTML)
-        {
-            json_html_util::prettyPrintJson(res);
-        }
-        else if (preferred == ContentType::CBOR)
+    using http_helpers::ContentType;
+    std::array<ContentType, 3> allowed{ContentType::CBOR, ContentType::JSON,
+                                       ContentType::HTML};
+    ContentType preferred = getPreferredContentType(accepts, allowed);
+
+    // Technically preferred could also be NoMatch here, but we'd like to
+    // default to json rather than return 400 for backward compatibility.
+    bool isJson =
+        preferred != ContentType::HTML && preferred != ContentType::CBOR;
+
+    bool stream = isJson && BMCWEB_EXPERIMENTAL_JSON_STREAMING && canChunk;
+
+    std::string json;
+    if (isJson && !stream)
+    {
+        // Serialize before computing the etag, so the etag is hashed from the
+        // output bytes instead of walking the tree a second time.
+        json = res.jsonValue.dump(jsonIndent, ' ', true,
+                                  nlohmann::json::error_handler_t::replace);
+        res.setHashAndHandleNotModified(json);
+    }
+    else
+    {
+        // A streamed body is serialized after the header goes out, so its
+        // etag comes from a separate pass that hashes in bounded chunks.
+        res.setHashAndHandleNotModified();
+    }
+
+    if (!res.jsonValue.is_structured())
+    {
+        // Not modified
+        return;
+    }
+
+    if (preferred == ContentType::HTML)
+    {
+        json_html_util::prettyPrintJson(res);
+    }
+    else if (preferred == ContentType::CBOR)
+    {
+        res.addHeader(boost::beast::http::field::content_type,
+                      "application/cbor");
+        std::string cbor;
+        nlohmann::json::to_cbor(res.jsonValue, cbor);
+        res.write(std::move(cbor));
+        compressResponse(acceptEncoding, res);
+    }
+    else
+    {
+        res.addHeader(boost::beast::http::field::content_type,
+                      "application/json");
+        if (stream)
         {
-            res.addHeader(boost::beast::http::field::content_type,
-                          "application/cbor");
-            std::string cbor;
-            nlohmann::json::to_cbor(res.jsonValue, cbor);
-            res.write(std::move(cbor));
+            res.response.body().setJson(
+                std::make_shared<const nlohmann::json>(
+                    std::move(res.jsonValue)),
+                jsonIndent);
         }
         else
         {
-            // Technically preferred could also be NoMatch here, but we'd
-            // like to default to something rather than return 400 for
-            // backward compatibility.
-            res.addHeader(boost::beast::http::field::content_type,
-                          "application/json");
-            res.write(res.jsonValue.dump(
-                2, ' ', true, nlohmann::json::error_handler_t::replace));
+            res.write(std::move(json));
         }
+        compressResponse(acceptEncoding, res);
     }
 }
 } // namespace crow
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace bmcweb
+{
+
+// Hashes serialized response bytes for use as an ETag.  Input is consumed in
+// fixed size blocks, so the result is the same whether the body is hashed in
+// one piece or fed incrementally while it is being serialized.
+class EtagHasher
+{
+  public:
+    static constexpr size_t blockSize = 1024UL * 64UL;
+
+    void update(std::string_view data)
+    {
+        if (!pending.empty())
+        {
+            size_t take = std::min(blockSize - pending.size(), data.size());
+            pending.append(data.substr(0, take));
+            data.remove_prefix(take);
+            if (pending.size() < blockSize)
+            {
+                return;
+            }
+            mix(pending);
+            pending.clear();
+        }
+        while (data.size() >= blockSize)
+        {
+            mix(data.substr(0, blockSize));
+            data.remove_prefix(blockSize);
+        }
+        pending.append(data);
+    }
+
+    size_t finish()
+    {
+        if (!pending.empty())
+        {
+            mix(pending);
+            pending.clear();
+        }
+        return hashval;
+    }
+
+  private:
+    void mix(std::string_view block)
+    {
+        size_t blockHash = std::hash<std::string_view>{}(block);
+        // Same combining step as boost::hash_combine
+        hashval ^= blockHash + 0x9e3779b9U + (hashval << 6U) + (hashval >> 2U);
+    }
+
+    std::string pending;
+    size_t hashval = 0;
+};
+
+} // namespace bmcweb
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include "logging.hpp"
+
+#include <zlib.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace bmcweb
+{
+
+// Totals across all compressed responses, for reporting the compression ratio
+struct CompressionStatistics
+{
+    uint64_t bytesIn = 0;
+    uint64_t bytesOut = 0;
+
+    static CompressionStatistics& getInstance()
+    {
+        static CompressionStatistics stats;
+        return stats;
+    }
+
+    // Compressed size over uncompressed size, 0 if nothing was compressed
+    double ratio() const
+    {
+        if (bytesIn == 0)
+        {
+            return 0.0;
+        }
+        return static_cast<double>(bytesOut) / static_cast<double>(bytesIn);
+    }
+};
+
+// Incremental gzip compressor for response bodies
+class GzipCompressor
+{
+  public:
+    GzipCompressor()
+    {
+        // 15 window bits, +16 selects the gzip wrapper rather than zlib
+        initialized = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                                   15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+        if (!initialized)
+        {
+            BMCWEB_LOG_ERROR("Failed to initialize gzip compressor");
+        }
+    }
+
+    GzipCompressor(const GzipCompressor&) = delete;
+    GzipCompressor(GzipCompressor&&) = delete;
+    GzipCompressor& operator=(const GzipCompressor&) = delete;
+    GzipCompressor& operator=(GzipCompressor&&) = delete;
+
+    ~GzipCompressor()
+    {
+        if (initialized)
+        {
+            deflateEnd(&stream);
+        }
+    }
+
+    // Compresses input and appends whatever compressed output is available to
+    // output.  The last call must set finish, which flushes the remaining
+    // output and the gzip trailer.  Returns false on error.
+    bool compress(std::string_view input, bool finish, std::string& output)
+    {
+        if (!initialized)
+        {
+            return false;
+        }
+        // zlib doesn't modify the input, but its API isn't const correct
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        stream.next_in = std::bit_cast<Bytef*>(const_cast<char*>(input.data()));
+        stream.avail_in = static_cast<uInt>(input.size());
+        int flush = finish ? Z_FINISH : Z_NO_FLUSH;
+        do
+        {
+            size_t oldSize = output.size();
+            output.resize(oldSize + outChunkSize);
+            stream.next_out = std::bit_cast<Bytef*>(&output[oldSize]);
+            stream.avail_out = static_cast<uInt>(outChunkSize);
+            int ret = deflate(&stream, flush);
+            output.resize(oldSize + outChunkSize - stream.avail_out);
+            if (ret == Z_STREAM_ERROR)
+            {
+                BMCWEB_LOG_ERROR("gzip compression failed");
+                return false;
+            }
+        } while (stream.avail_out == 0);
+
+        if (finish)
+        {
+            CompressionStatistics& stats = CompressionStatistics::getInstance();
+            stats.bytesIn += stream.total_in;
+            stats.bytesOut += stream.total_out;
+            BMCWEB_LOG_DEBUG("Compressed {} bytes to {}", stream.total_in,
+                             stream.total_out);
+        }
+        return true;
+    }
+
+  private:
+    static constexpr size_t outChunkSize = 1024UL * 16UL;
+
+    z_stream stream{};
+    bool initialized = false;
+};
+
+} // namespace bmcweb
@@ -52,6 +52,7 @@ struct Http2StreamData
     std::shared_ptr<Request> req = std::make_shared<Request>();
     std::optional<bmcweb::HttpBody::reader> reqReader;
     std::string accept;
+    std::string acceptEncoding;
     Response res;
     std::optional<bmcweb::HttpBody::writer> writer;
 };
@@ -205,9 +206,11 @@ class HTTP2Connection :
         Response& res = stream.res;
         res = std::move(completedRes);
 
-        completeResponseFields(stream.accept, res);
+        completeResponseFields(stream.accept, stream.acceptEncoding, true, res);
         res.addHeader(boost::beast::http::field::date, getCachedDateStr());
         res.preparePayload();
+        // HTTP/2 frames the body itself; chunked encoding is not allowed
+        res.clearHeader(boost::beast::http::field::transfer_encoding);
 
         boost::beast::http::fields& fields = res.fields();
         std::string code = std::to_string(res.resultInt());
@@ -278,6 +281,8 @@ class HTTP2Connection :
         }
         crow::Request& thisReq = *it->second.req;
         it->second.accept = thisReq.getHeaderValue("Accept");
+        it->second.acceptEncoding =
+            thisReq.getHeaderValue(boost::beast::http::field::accept_encoding);
 
         BMCWEB_LOG_DEBUG("Handling {} \"{}\"", logPtr(&thisReq),
                          thisReq.url().encoded_path());
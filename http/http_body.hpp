@@ -3,6 +3,8 @@
 #pragma once
 
 #include "duplicatable_file_handle.hpp"
+#include "gzip_compressor.hpp"
+#include "json_stream_serializer.hpp"
 #include "logging.hpp"
 #include "utility.hpp"
 
@@ -18,12 +20,14 @@
 #include <boost/none.hpp>
 #include <boost/optional/optional.hpp>
 #include <boost/system/error_code.hpp>
+#include <nlohmann/json.hpp>
 
 #include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -49,17 +53,29 @@ enum class EncodingType
     Base64,
 };
 
+enum class CompressionType
+{
+    None,
+    Gzip,
+};
+
 class HttpBody::value_type
 {
     DuplicatableFileHandle fileHandle;
     std::optional<size_t> fileSize;
     std::string strBody;
+    std::shared_ptr<const std::string> sharedStrBody;
+    std::shared_ptr<const nlohmann::json> jsonBody;
+    int jsonBodyIndent = -1;
 
   public:
     value_type() = default;
     explicit value_type(std::string_view s) : strBody(s) {}
     explicit value_type(EncodingType e) : encodingType(e) {}
     EncodingType encodingType = EncodingType::Raw;
+    // Compression is applied while the body is written, so the compressed
+    // size isn't known up front and the body is sent chunked.
+    CompressionType compression = CompressionType::None;
 
     const boost::beast::file_posix& file() const
     {
@@ -76,11 +92,50 @@ class HttpBody::value_type
         return strBody;
     }
 
+    // Sets a string body that is shared with other messages rather than
+    // copied into each one.  Takes precedence over str().
+    void setSharedStr(std::shared_ptr<const std::string> s)
+    {
+        sharedStrBody = std::move(s);
+    }
+
+    // The string body that will be written, shared or not
+    std::string_view strView() const
+    {
+        if (sharedStrBody != nullptr)
+        {
+            return *sharedStrBody;
+        }
+        return strBody;
+    }
+
+    // Sets a json tree to be serialized incrementally as the body is written.
+    // The size isn't known up front, so the body is sent chunked.
+    void setJson(std::shared_ptr<const nlohmann::json> json, int indent)
+    {
+        jsonBody = std::move(json);
+        jsonBodyIndent = indent;
+    }
+
+    const std::shared_ptr<const nlohmann::json>& json() const
+    {
+        return jsonBody;
+    }
+
+    int jsonIndent() const
+    {
+        return jsonBodyIndent;
+    }
+
     std::optional<size_t> payloadSize() const
     {
+        if (jsonBody != nullptr || compression != CompressionType::None)
+        {
+            return std::nullopt;
+        }
         if (!fileHandle.fileHandle.is_open())
         {
-            return strBody.size();
+            return strView().size();
         }
         if (fileSize)
         {
@@ -96,9 +151,13 @@ class HttpBody::value_type
     {
         strBody.clear();
         strBody.shrink_to_fit();
+        sharedStrBody = nullptr;
+        jsonBody = nullptr;
+        jsonBodyIndent = -1;
         fileHandle.fileHandle = boost::beast::file_posix();
         fileSize = std::nullopt;
         encodingType = EncodingType::Raw;
+        compression = CompressionType::None;
     }
 
     void open(const char* path, boost::beast::file_mode mode,
@@ -145,6 +204,23 @@ class HttpBody::value_type
         }
         ec = {};
     }
+
+    // Appends to the open file.  Used for request bodies that are received
+    // into a file rather than str().
+    void appendToFile(std::string_view data, boost::system::error_code& ec)
+    {
+        while (!data.empty())
+        {
+            size_t written = fileHandle.fileHandle.write(data.data(),
+                                                         data.size(), ec);
+            if (ec)
+            {
+                return;
+            }
+            data.remove_prefix(written);
+            fileSize = fileSize.value_or(0U) + written;
+        }
+    }
 };
 
 class HttpBody::writer
@@ -165,11 +241,28 @@ class HttpBody::writer
     constexpr static size_t readBufSize = 1024UL * 64UL;
     std::array<char, readBufSize> fileReadBuf{};
 
+    std::optional<JsonStreamSerializer> jsonSerializer;
+    std::string_view jsonChunk;
+
+    std::optional<GzipCompressor> compressor;
+    std::string compressedBuf;
+    std::string_view compressedChunk;
+    bool compressionDone = false;
+
   public:
     template <bool IsRequest, class Fields>
     writer(boost::beast::http::header<IsRequest, Fields>& /*header*/,
            value_type& bodyIn) : body(bodyIn)
-    {}
+    {
+        if (body.json() != nullptr)
+        {
+            jsonSerializer.emplace(*body.json(), body.jsonIndent());
+        }
+        if (body.compression == CompressionType::Gzip)
+        {
+            compressor.emplace();
+        }
+    }
 
     static void init(boost::beast::error_code& ec)
     {
@@ -184,16 +277,86 @@ class HttpBody::writer
 
     boost::optional<std::pair<const_buffers_type, bool>> getWithMaxSize(
         boost::beast::error_code& ec, size_t maxSize)
+    {
+        if (compressor)
+        {
+            return getCompressed(ec, maxSize);
+        }
+        return getUncompressed(ec, maxSize);
+    }
+
+  private:
+    // Pulls uncompressed chunks through the compressor until it produces
+    // output, then hands that out in pieces of at most maxSize.
+    boost::optional<std::pair<const_buffers_type, bool>> getCompressed(
+        boost::beast::error_code& ec, size_t maxSize)
+    {
+        if (compressedChunk.empty())
+        {
+            compressedBuf.clear();
+        }
+        while (compressedChunk.empty() && !compressionDone)
+        {
+            boost::optional<std::pair<const_buffers_type, bool>> raw =
+                getUncompressed(ec, readBufSize);
+            if (ec)
+            {
+                return boost::none;
+            }
+            std::string_view input;
+            bool finish = true;
+            if (raw)
+            {
+                input = std::string_view(
+                    static_cast<const char*>(raw->first.data()),
+                    raw->first.size());
+                finish = !raw->second;
+            }
+            if (!compressor->compress(input, finish, compressedBuf))
+            {
+                ec = boost::system::errc::make_error_code(
+                    boost::system::errc::io_error);
+                return boost::none;
+            }
+            compressionDone = finish;
+            compressedChunk = compressedBuf;
+        }
+
+        std::pair<const_buffers_type, bool> ret;
+        size_t toReturn = std::min(maxSize, compressedChunk.size());
+        ret.first = const_buffers_type(compressedChunk.data(), toReturn);
+        compressedChunk.remove_prefix(toReturn);
+        ret.second = !compressedChunk.empty() || !compressionDone;
+        return ret;
+    }
+
+    boost::optional<std::pair<const_buffers_type, bool>> getUncompressed(
+        boost::beast::error_code& ec, size_t maxSize)
     {
         std::pair<const_buffers_type, bool> ret;
+        if (jsonSerializer)
+        {
+            if (jsonChunk.empty())
+            {
+                jsonChunk = jsonSerializer->next(readBufSize);
+            }
+            size_t toReturn = std::min(maxSize, jsonChunk.size());
+            ret.first = const_buffers_type(jsonChunk.data(), toReturn);
+            jsonChunk.remove_prefix(toReturn);
+            ret.second = !jsonChunk.empty() || !jsonSerializer->isDone();
+            BMCWEB_LOG_DEBUG("Returning {} bytes of json more={}",
+                             ret.first.size(), ret.second);
+            return ret;
+        }
         if (!body.file().is_open())
         {
-            size_t remain = body.str().size() - sent;
+            std::string_view str = body.strView();
+            size_t remain = str.size() - sent;
             size_t toReturn = std::min(maxSize, remain);
-            ret.first = const_buffers_type(&body.str()[sent], toReturn);
+            ret.first = const_buffers_type(str.data() + sent, toReturn);
 
             sent += toReturn;
-            ret.second = sent < body.str().size();
+            ret.second = sent < str.size();
             BMCWEB_LOG_INFO("Returning {} bytes more={}", ret.first.size(),
                             ret.second);
             return ret;
@@ -267,12 +430,24 @@ class HttpBody::reader
                     boost::system::error_code& ec)
     {
         size_t extra = boost::beast::buffer_bytes(buffers);
+        ec = {};
         for (const auto b : boost::beast::buffers_range_ref(buffers))
         {
-            const char* ptr = static_cast<const char*>(b.data());
-            value.str() += std::string_view(ptr, b.size());
+            std::string_view chunk(static_cast<const char*>(b.data()),
+                                   b.size());
+            if (value.file().is_open())
+            {
+                value.appendToFile(chunk, ec);
+                if (ec)
+                {
+                    BMCWEB_LOG_ERROR("Failed to write body to file {}",
+                                     ec.message());
+                    return 0;
+                }
+                continue;
+            }
+            value.str() += chunk;
         }
-        ec = {};
         return extra;
     }
 
@@ -44,7 +44,9 @@
 #include <boost/url/url.hpp>
 #include <boost/url/url_view_base.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <format>
@@ -120,6 +122,28 @@ struct ConnectionPolicy
     std::chrono::seconds retryIntervalSecs = std::chrono::seconds(0);
     std::function<boost::system::error_code(unsigned int respCode)>
         invalidResp = defaultRetryHandler;
+
+    // Number of requests written to a connection before reading their
+    // responses (HTTP/1.1 pipelining).  1 disables pipelining.  Together with
+    // maxConnections, this bounds the number of requests in flight.
+    size_t pipelineDepth = 1;
+
+    // Responses slower than this are taken as a sign that the destination is
+    // overloaded, and reduce the number of requests in flight
+    std::chrono::milliseconds latencyTarget = std::chrono::seconds(5);
+};
+
+struct ConnectionPoolStatistics
+{
+    // Requests waiting for a connection
+    size_t queueDepth = 0;
+    // Requests handed to a connection that haven't completed yet
+    size_t inFlight = 0;
+    // Requests rejected because the queue was full
+    uint64_t dropped = 0;
+    size_t connections = 0;
+    // Number of requests currently allowed in flight
+    size_t concurrencyLimit = 0;
 };
 
 struct PendingRequest
@@ -144,16 +168,22 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
     boost::urls::url host;
     ensuressl::VerifyCertificate verifyCert;
     uint32_t connId;
+    // Shared by the connections of a pool, to resume TLS sessions
+    std::shared_ptr<ensuressl::ClientSessionCache> tlsSessions;
+    // Requests handed to this connection, oldest first.  When pipelining,
+    // all of them are written before the responses are read, which arrive
+    // in the same order.
+    boost::container::devector<PendingRequest> requests;
+    // Number of requests written since the connection was (re)established
+    size_t requestsWritten = 0;
+    // When the current requests were handed to this connection
+    std::chrono::steady_clock::time_point requestStart;
     // Data buffers
-    http::request<bmcweb::HttpBody> req;
     using parser_type = http::response_parser<bmcweb::HttpBody>;
     std::optional<parser_type> parser;
     boost::beast::flat_static_buffer<httpReadBufferSize> buffer;
     Response res;
 
-    // Ascync callables
-    std::function<void(bool, uint32_t, Response&)> callback;
-
     boost::asio::io_context& ioc;
 
     using Resolver = std::conditional_t<BMCWEB_DNS_RESOLVER == "systemd-dbus",
@@ -272,17 +302,32 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
             return;
         }
         BMCWEB_LOG_DEBUG("SSL Handshake successful - id: {}", connId);
+        ensuressl::countHandshake(ensuressl::getClientTlsStatistics(),
+                                  sslConn->native_handle());
+        tlsSessions->save(sslConn->native_handle());
         state = ConnState::connected;
         sendMessage();
     }
 
     void sendMessage()
     {
+        if (requests.empty())
+        {
+            state = ConnState::idle;
+            return;
+        }
         state = ConnState::sendInProgress;
+        requestsWritten = 0;
+        writeRequest();
+    }
 
+    // Writes the oldest request that hasn't been written yet
+    void writeRequest()
+    {
         // Set a timeout on the operation
         timer.expires_after(std::chrono::seconds(30));
         timer.async_wait(std::bind_front(onTimeout, weak_from_this()));
+        http::request<bmcweb::HttpBody>& req = requests[requestsWritten].req;
         // Send the HTTP request to the remote host
         if (sslConn)
         {
@@ -321,6 +366,12 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
         BMCWEB_LOG_DEBUG("sendMessage() bytes transferred: {}",
                          bytesTransferred);
 
+        requestsWritten++;
+        if (requestsWritten < requests.size())
+        {
+            writeRequest();
+            return;
+        }
         recvMessage();
     }
 
@@ -411,14 +462,40 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
         // Reset the counter just in case this was after retrying
         retryCount = 0;
 
+        if (sslConn)
+        {
+            // Pick up any session ticket sent after the handshake
+            tlsSessions->save(sslConn->native_handle());
+        }
+
         // Keep the connection alive if server supports it
         // Else close the connection
-        BMCWEB_LOG_DEBUG("recvMessage() keepalive : {}", parser->keep_alive());
+        bool keepAlive = parser->keep_alive();
+        BMCWEB_LOG_DEBUG("recvMessage() keepalive : {}", keepAlive);
 
         // Copy the response into a Response object so that it can be
         // processed by the callback function.
         res.response = parser->release();
-        callback(parser->keep_alive(), connId, res);
+        PendingRequest done = std::move(requests.front());
+        requests.pop_front();
+        requestsWritten--;
+
+        if (!requests.empty())
+        {
+            if (keepAlive)
+            {
+                // The responses to the rest of the pipelined requests follow
+                // on this connection
+                recvMessage();
+            }
+            else
+            {
+                // The server won't answer the rest, so send them again on a
+                // new connection
+                doClose(true);
+            }
+        }
+        done.callback(keepAlive, connId, res);
         res.clear();
     }
 
@@ -463,15 +540,22 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
                 state = ConnState::suspended;
             }
 
-            // We want to return a 502 to indicate there was an error with
-            // the external server
-            res.result(boost::beast::http::status::bad_gateway);
-            callback(false, connId, res);
-            res.clear();
-
             // Reset the retrycount to zero so that client can try
             // connecting again if needed
             retryCount = 0;
+            requestsWritten = 0;
+
+            // We want to return a 502 to indicate there was an error with
+            // the external server, for every request that wasn't answered.
+            // The callbacks may hand new requests to this connection.
+            boost::container::devector<PendingRequest> failed;
+            failed.swap(requests);
+            for (PendingRequest& pending : failed)
+            {
+                res.result(boost::beast::http::status::bad_gateway);
+                pending.callback(false, connId, res);
+                res.clear();
+            }
             return;
         }
 
@@ -632,6 +716,7 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
             }
             sslConn.emplace(conn, *sslCtx);
             setCipherSuiteTLSext();
+            tlsSessions->apply(sslConn->native_handle());
         }
     }
 
@@ -640,10 +725,11 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
         boost::asio::io_context& iocIn, const std::string& idIn,
         const std::shared_ptr<ConnectionPolicy>& connPolicyIn,
         const boost::urls::url_view_base& hostIn,
-        ensuressl::VerifyCertificate verifyCertIn, unsigned int connIdIn) :
+        ensuressl::VerifyCertificate verifyCertIn, unsigned int connIdIn,
+        const std::shared_ptr<ensuressl::ClientSessionCache>& tlsSessionsIn) :
         subId(idIn), connPolicy(connPolicyIn), host(hostIn),
-        verifyCert(verifyCertIn), connId(connIdIn), ioc(iocIn), resolver(iocIn),
-        conn(iocIn), timer(iocIn)
+        verifyCert(verifyCertIn), connId(connIdIn), tlsSessions(tlsSessionsIn),
+        ioc(iocIn), resolver(iocIn), conn(iocIn), timer(iocIn)
     {
         initializeConnection(host.scheme() == "https");
     }
@@ -659,11 +745,23 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
     std::vector<std::shared_ptr<ConnectionInfo>> connections;
     boost::container::devector<PendingRequest> requestQueue;
     ensuressl::VerifyCertificate verifyCert;
+    std::shared_ptr<ensuressl::ClientSessionCache> tlsSessions =
+        std::make_shared<ensuressl::ClientSessionCache>();
+
+    // Number of requests allowed in flight, over all connections.  Starts at
+    // getMaxInFlight() and is adjusted from the outcome of every request: it
+    // is halved when a request fails or is slow, and grows by one for each
+    // window of successful requests while requests are waiting (AIMD).
+    // Destinations that get one connection, such as event subscriptions
+    // that must stay in order, adapt through the depth of the pipeline.
+    size_t concurrencyLimit;
+    size_t successesSinceIncrease = 0;
+    uint64_t droppedRequests = 0;
 
     friend class HttpClient;
 
-    // Configure a connections's request, callback, and retry info in
-    // preparation to begin sending the request
+    // Move the next requests in the queue to a connection in preparation to
+    // begin sending them
     void setConnProps(ConnectionInfo& conn)
     {
         if (requestQueue.empty())
@@ -673,31 +771,139 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
             return;
         }
 
-        PendingRequest& nextReq = requestQueue.front();
-        conn.req = std::move(nextReq.req);
-        conn.callback = std::move(nextReq.callback);
-
         BMCWEB_LOG_DEBUG("Setting properties for connection {}, id: {}",
                          conn.host, conn.connId);
 
-        // We can remove the request from the queue at this point
-        requestQueue.pop_front();
+        // Pipeline no more requests than the concurrency limit allows, but
+        // always at least one so that the queue keeps moving
+        size_t depth = std::max<size_t>(connPolicy->pipelineDepth, 1);
+        size_t inFlight = getInFlightCount();
+        if (concurrencyLimit > inFlight)
+        {
+            depth = std::min(depth, concurrencyLimit - inFlight);
+        }
+        else
+        {
+            depth = 1;
+        }
+        while (!requestQueue.empty() && conn.requests.size() < depth)
+        {
+            // We can remove the request from the queue at this point
+            conn.requests.emplace_back(std::move(requestQueue.front()));
+            requestQueue.pop_front();
+        }
+        conn.requestStart = std::chrono::steady_clock::now();
+    }
+
+    size_t getInFlightCount() const
+    {
+        size_t inFlight = 0;
+        for (const std::shared_ptr<ConnectionInfo>& conn : connections)
+        {
+            inFlight += conn->requests.size();
+        }
+        return inFlight;
+    }
+
+    size_t getMaxInFlight() const
+    {
+        return std::max<size_t>(connPolicy->maxConnections, 1) *
+               std::max<size_t>(connPolicy->pipelineDepth, 1);
+    }
+
+    void updateConcurrencyLimit(bool succeeded,
+                                std::chrono::steady_clock::duration latency)
+    {
+        if (!succeeded || latency > connPolicy->latencyTarget)
+        {
+            successesSinceIncrease = 0;
+            size_t newLimit = std::max<size_t>(concurrencyLimit / 2, 1);
+            if (newLimit != concurrencyLimit)
+            {
+                BMCWEB_LOG_DEBUG("Reducing concurrency of pool {} to {}", id,
+                                 newLimit);
+                concurrencyLimit = newLimit;
+            }
+            return;
+        }
+
+        // Only grow while requests are waiting for a connection
+        if (requestQueue.empty() || concurrencyLimit >= getMaxInFlight())
+        {
+            return;
+        }
+        successesSinceIncrease++;
+        if (successesSinceIncrease >= concurrencyLimit)
+        {
+            successesSinceIncrease = 0;
+            concurrencyLimit++;
+            BMCWEB_LOG_DEBUG("Raising concurrency of pool {} to {}", id,
+                             concurrencyLimit);
+        }
+    }
+
+    // Hands queued requests to free connections, adding connections if
+    // needed, while fewer than concurrencyLimit requests are in flight
+    void sendQueued()
+    {
+        while (!requestQueue.empty() && getInFlightCount() < concurrencyLimit)
+        {
+            auto it = std::ranges::find_if(
+                connections, [](const std::shared_ptr<ConnectionInfo>& conn) {
+                    return conn->requests.empty() &&
+                           ((conn->state == ConnState::idle) ||
+                            (conn->state == ConnState::initialized) ||
+                            (conn->state == ConnState::closed));
+                });
+            if (it == connections.end())
+            {
+                if (connections.size() >= connPolicy->maxConnections)
+                {
+                    return;
+                }
+                BMCWEB_LOG_DEBUG("Adding new connection to pool {}", id);
+                std::shared_ptr<ConnectionInfo> conn = addConnection();
+                setConnProps(*conn);
+                conn->doResolve();
+                continue;
+            }
+
+            // Keep a reference, as sending can add to connections
+            std::shared_ptr<ConnectionInfo> conn = *it;
+            setConnProps(*conn);
+            std::string commonMsg =
+                std::format("{} from pool {}", conn->connId, id);
+            if (conn->state == ConnState::idle)
+            {
+                BMCWEB_LOG_DEBUG("Grabbing idle connection {}", commonMsg);
+                conn->sendMessage();
+            }
+            else
+            {
+                BMCWEB_LOG_DEBUG("Reusing existing connection {}", commonMsg);
+                conn->restartConnection();
+            }
+        }
     }
 
     // Gets called as part of callback after request is sent
     // Reuses the connection if there are any requests waiting to be sent
     // Otherwise closes the connection if it is not a keep-alive
-    void sendNext(bool keepAlive, uint32_t connId)
+    void sendNext(bool keepAlive, uint32_t connId, bool succeeded)
     {
         auto conn = connections[connId];
 
-        // Allow the connection's handler to be deleted
-        // This is needed because of Redfish Aggregation passing an
-        // AsyncResponse shared_ptr to this callback
-        conn->callback = nullptr;
+        updateConcurrencyLimit(
+            succeeded, std::chrono::steady_clock::now() - conn->requestStart);
+
+        // Wait for the responses to the rest of the pipelined requests
+        if (!conn->requests.empty())
+        {
+            return;
+        }
 
         // Reuse the connection to send the next request in the queue
-        if (!requestQueue.empty())
+        if (!requestQueue.empty() && getInFlightCount() < concurrencyLimit)
         {
             BMCWEB_LOG_DEBUG(
                 "{} requests remaining in queue for {}, reusing connection {}",
@@ -716,6 +922,8 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
                 conn->doClose();
                 conn->restartConnection();
             }
+            // The limit might have grown, allowing more requests
+            sendQueued();
             return;
         }
 
@@ -732,72 +940,42 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
         }
     }
 
-    void sendData(std::string&& data, const boost::urls::url_view_base& destUri,
+    void sendData(std::shared_ptr<const std::string> data,
+                  const boost::urls::url_view_base& destUri,
                   const boost::beast::http::fields& httpHeader,
                   const boost::beast::http::verb verb,
                   const std::function<void(Response&)>& resHandler)
     {
+        if (requestQueue.size() >= maxRequestQueueSize)
+        {
+            // If we can't buffer the request then we should let the
+            // callback handle a 429 Too Many Requests dummy response
+            droppedRequests++;
+            BMCWEB_LOG_ERROR(
+                "{} request queue full.  Dropping request, {} dropped so far",
+                id, droppedRequests);
+            Response dummyRes;
+            dummyRes.result(boost::beast::http::status::too_many_requests);
+            resHandler(dummyRes);
+            return;
+        }
+
         // Construct the request to be sent
         boost::beast::http::request<bmcweb::HttpBody> thisReq(
             verb, destUri.encoded_target(), 11, "", httpHeader);
         thisReq.set(boost::beast::http::field::host,
                     destUri.encoded_host_address());
         thisReq.keep_alive(true);
-        thisReq.body().str() = std::move(data);
+        thisReq.body().setSharedStr(std::move(data));
         thisReq.prepare_payload();
         auto cb = std::bind_front(&ConnectionPool::afterSendData,
                                   weak_from_this(), resHandler);
-        // Reuse an existing connection if one is available
-        for (unsigned int i = 0; i < connections.size(); i++)
-        {
-            auto conn = connections[i];
-            if ((conn->state == ConnState::idle) ||
-                (conn->state == ConnState::initialized) ||
-                (conn->state == ConnState::closed))
-            {
-                conn->req = std::move(thisReq);
-                conn->callback = std::move(cb);
-                std::string commonMsg = std::format("{} from pool {}", i, id);
-
-                if (conn->state == ConnState::idle)
-                {
-                    BMCWEB_LOG_DEBUG("Grabbing idle connection {}", commonMsg);
-                    conn->sendMessage();
-                }
-                else
-                {
-                    BMCWEB_LOG_DEBUG("Reusing existing connection {}",
-                                     commonMsg);
-                    conn->restartConnection();
-                }
-                return;
-            }
-        }
-
-        // All connections in use so create a new connection or add request
-        // to the queue
-        if (connections.size() < connPolicy->maxConnections)
-        {
-            BMCWEB_LOG_DEBUG("Adding new connection to pool {}", id);
-            auto conn = addConnection();
-            conn->req = std::move(thisReq);
-            conn->callback = std::move(cb);
-            conn->doResolve();
-        }
-        else if (requestQueue.size() < maxRequestQueueSize)
-        {
-            BMCWEB_LOG_DEBUG("Max pool size reached. Adding data to queue {}",
-                             id);
-            requestQueue.emplace_back(std::move(thisReq), std::move(cb));
-        }
-        else
+        requestQueue.emplace_back(std::move(thisReq), std::move(cb));
+        sendQueued();
+        if (!requestQueue.empty())
         {
-            // If we can't buffer the request then we should let the
-            // callback handle a 429 Too Many Requests dummy response
-            BMCWEB_LOG_ERROR("{} request queue full.  Dropping request.", id);
-            Response dummyRes;
-            dummyRes.result(boost::beast::http::status::too_many_requests);
-            resHandler(dummyRes);
+            BMCWEB_LOG_DEBUG("{} requests in flight. {} requests queued for {}",
+                             getInFlightCount(), requestQueue.size(), id);
         }
     }
 
@@ -806,6 +984,13 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
                               const std::function<void(Response&)>& resHandler,
                               bool keepAlive, uint32_t connId, Response& res)
     {
+        // Server errors and rate limiting mean the destination is struggling
+        unsigned int respCode = res.resultInt();
+        bool succeeded = respCode < 500 &&
+                         respCode != static_cast<unsigned int>(
+                                         boost::beast::http::status::
+                                             too_many_requests);
+
         // Allow provided callback to perform additional processing of the
         // request
         resHandler(res);
@@ -820,15 +1005,14 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
             return;
         }
 
-        self->sendNext(keepAlive, connId);
+        self->sendNext(keepAlive, connId, succeeded);
     }
-
     std::shared_ptr<ConnectionInfo>& addConnection()
     {
         unsigned int newId = static_cast<unsigned int>(connections.size());
 
         auto& ret = connections.emplace_back(std::make_shared<ConnectionInfo>(
-            ioc, id, connPolicy, destIP, verifyCert, newId));
+            ioc, id, connPolicy, destIP, verifyCert, newId, tlsSessions));
 
         BMCWEB_LOG_DEBUG("Added connection {} to pool {}",
                          connections.size() - 1, id);
@@ -843,7 +1027,7 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
         const boost::urls::url_view_base& destIPIn,
         ensuressl::VerifyCertificate verifyCertIn) :
         ioc(iocIn), id(idIn), connPolicy(connPolicyIn), destIP(destIPIn),
-        verifyCert(verifyCertIn)
+        verifyCert(verifyCertIn), concurrencyLimit(getMaxInFlight())
     {
         BMCWEB_LOG_DEBUG("Initializing connection pool for {}", id);
 
@@ -871,6 +1055,17 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
         BMCWEB_LOG_INFO("All connections of pool id:{} are terminated", id);
         return true;
     }
+
+    ConnectionPoolStatistics getStatistics() const
+    {
+        ConnectionPoolStatistics stats;
+        stats.queueDepth = requestQueue.size();
+        stats.inFlight = getInFlightCount();
+        stats.dropped = droppedRequests;
+        stats.connections = connections.size();
+        stats.concurrencyLimit = concurrencyLimit;
+        return stats;
+    }
 };
 
 class HttpClient
@@ -924,6 +1119,20 @@ class HttpClient
                               const boost::beast::http::fields& httpHeader,
                               const boost::beast::http::verb verb,
                               const std::function<void(Response&)>& resHandler)
+    {
+        sendDataWithCallback(
+            std::make_shared<const std::string>(std::move(data)), destUrl,
+            verifyCert, httpHeader, verb, resHandler);
+    }
+
+    // Same as above, for a body that is shared between several requests, for
+    // example one event sent to many subscribers.  The body isn't copied.
+    void sendDataWithCallback(std::shared_ptr<const std::string> data,
+                              const boost::urls::url_view_base& destUrl,
+                              ensuressl::VerifyCertificate verifyCert,
+                              const boost::beast::http::fields& httpHeader,
+                              const boost::beast::http::verb verb,
+                              const std::function<void(Response&)>& resHandler)
     {
         std::string_view verify = "ssl_verify";
         if (verifyCert == ensuressl::VerifyCertificate::NoVerify)
@@ -961,5 +1170,25 @@ class HttpClient
         BMCWEB_LOG_DEBUG("All client connections are terminated");
         return true;
     }
+
+    // Totals over the pools for every destination
+    ConnectionPoolStatistics getStatistics() const
+    {
+        ConnectionPoolStatistics stats;
+        for (const auto& pool : connectionPools)
+        {
+            if (pool.second == nullptr)
+            {
+                continue;
+            }
+            ConnectionPoolStatistics poolStats = pool.second->getStatistics();
+            stats.queueDepth += poolStats.queueDepth;
+            stats.inFlight += poolStats.inFlight;
+            stats.dropped += poolStats.dropped;
+            stats.connections += poolStats.connections;
+            stats.concurrencyLimit += poolStats.concurrencyLimit;
+        }
+        return stats;
+    }
 };
 } // namespace crow
@@ -17,9 +17,12 @@
 #include "logging.hpp"
 #include "mutual_tls.hpp"
 #include "sessions.hpp"
+#include "ssl_key_handler.hpp"
 #include "str_utility.hpp"
 #include "utility.hpp"
 
+#include <sys/mman.h>
+
 #include <boost/asio/error.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/ssl/error.hpp>
@@ -42,8 +45,12 @@
 #include <boost/beast/http/verb.hpp>
 #include <boost/none.hpp>
 #include <boost/optional/optional.hpp>
+#include <boost/system/result.hpp>
+#include <boost/url/parse.hpp>
+#include <boost/url/url_view.hpp>
 
 #include <bit>
+#include <cerrno>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -246,6 +253,18 @@ class Connection :
             return;
         }
         BMCWEB_LOG_DEBUG("{} SSL handshake succeeded", logPtr(this));
+        ensuressl::countHandshake(ensuressl::getServerTlsStatistics(),
+                                  adaptor.native_handle());
+        if constexpr (BMCWEB_MUTUAL_TLS_AUTH)
+        {
+            // The verify callback doesn't run when a session is resumed
+            if (mtlsSession == nullptr &&
+                SSL_session_reused(adaptor.native_handle()) == 1)
+            {
+                mtlsSession =
+                    verifyResumedMtlsUser(ip, adaptor.native_handle());
+            }
+        }
         // If http2 is enabled, negotiate the protocol
         if constexpr (BMCWEB_EXPERIMENTAL_HTTP2)
         {
@@ -385,6 +404,15 @@ class Connection :
         }
         req->session = userSession;
         accept = req->getHeaderValue("Accept");
+        // A compressed body has no length up front and HTTP/1.0 can't chunk
+        // it, so 1.0 clients always get the identity encoding.  Assigned on
+        // every request so a keep-alive connection doesn't carry it over.
+        acceptEncoding.clear();
+        if (req->version() != 10)
+        {
+            acceptEncoding =
+                req->getHeaderValue(boost::beast::http::field::accept_encoding);
+        }
         // Fetch the client IP address
         req->ipAddress = ip;
 
@@ -516,7 +544,9 @@ class Connection :
             }
         }
 
-        completeResponseFields(accept, res);
+        // HTTP/1.0 has no chunked encoding, so the body needs a length
+        completeResponseFields(accept, acceptEncoding, req->version() != 10,
+                               res);
         res.addHeader(boost::beast::http::field::date, getCachedDateStr());
 
         doWrite();
@@ -563,6 +593,35 @@ class Connection :
         return httpReqBodyLimit;
     }
 
+    // Routes that take large uploads have their body written to a memfd as
+    // it arrives, so the whole body is never held in a string.  Bodies from
+    // logged out users are small enough that this is never worthwhile.
+    void prepareBodyFile()
+    {
+        if (!parser || getContentLengthLimit() <= loggedOutPostBodyLimit)
+        {
+            return;
+        }
+        boost::system::result<boost::urls::url_view> url =
+            boost::urls::parse_relative_ref(parser->get().target());
+        if (!url ||
+            !handler->streamsBodyToFile(parser->get().method(),
+                                        url->encoded_path()))
+        {
+            return;
+        }
+        int fd = memfd_create("bmcweb-request-body", MFD_CLOEXEC);
+        if (fd < 0)
+        {
+            BMCWEB_LOG_WARNING("{} Failed to create body memfd, errno {}",
+                               logPtr(this), errno);
+            return;
+        }
+        boost::system::error_code ec;
+        parser->get().body().setFd(fd, ec);
+        BMCWEB_LOG_DEBUG("{} Receiving body into memfd {}", logPtr(this), fd);
+    }
+
     // Returns true if content length was within limits
     // Returns false if content length error has been returned
     bool handleContentLengthError()
@@ -656,6 +715,8 @@ class Connection :
                 ip, res, method, parser->get().base(), mtlsSession);
         }
 
+        prepareBodyFile();
+
         std::string_view expect =
             parser->get()[boost::beast::http::field::expect];
         if (bmcweb::asciiIEquals(expect, "100-continue"))
@@ -954,6 +1015,7 @@ class Connection :
 
     std::shared_ptr<crow::Request> req;
     std::string accept;
+    std::string acceptEncoding;
     std::string http2settings;
     crow::Response res;
 
@@ -4,8 +4,10 @@
 
 #include "http_body.hpp"
 #include "sessions.hpp"
+#include "utility.hpp"
 
 #include <boost/asio/ip/address.hpp>
+#include <boost/beast/core/file_posix.hpp>
 #include <boost/beast/http/field.hpp>
 #include <boost/beast/http/fields.hpp>
 #include <boost/beast/http/message.hpp>
@@ -15,7 +17,9 @@
 #include <boost/url/url.hpp>
 #include <boost/url/url_view.hpp>
 
+#include <functional>
 #include <memory>
+#include <ostream>
 #include <string>
 #include <string_view>
 #include <system_error>
@@ -142,6 +146,39 @@ struct Request : std::enable_shared_from_this<Request>
         return req.body().str();
     }
 
+    // The file the body was received into, for routes registered with
+    // streamBodyToFile().  -1 if the body is held in body() instead.
+    int bodyFd() const
+    {
+        const boost::beast::file_posix& file = req.body().file();
+        if (!file.is_open())
+        {
+            return -1;
+        }
+        return file.native_handle();
+    }
+
+    // Passes the body to sink, a chunk at a time when it was received into a
+    // file.  See utility::drainFile().  Returns false if reading fails or sink
+    // returns false.
+    bool drainBody(const std::function<bool(std::string_view)>& sink) const
+    {
+        int fd = bodyFd();
+        if (fd == -1)
+        {
+            return sink(body());
+        }
+        return utility::drainFile(fd, sink);
+    }
+
+    bool drainBodyTo(std::ostream& out) const
+    {
+        return drainBody([&out](std::string_view chunk) {
+            out << chunk;
+            return !out.bad();
+        });
+    }
+
     bool target(std::string_view target)
     {
         req.target(target);
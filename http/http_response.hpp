@@ -1,7 +1,11 @@
 // SPDX-License-Identifier: Apache-2.0
 // SPDX-FileCopyrightText: Copyright OpenBMC Authors
 #pragma once
+#include "bmcweb_config.h"
+
+#include "etag_hasher.hpp"
 #include "http_body.hpp"
+#include "json_stream_serializer.hpp"
 #include "logging.hpp"
 #include "utils/hex_utils.hpp"
 
@@ -32,6 +36,9 @@ class Connection;
 
 namespace http = boost::beast::http;
 
+// Indentation used for application/json responses, as passed to json::dump
+constexpr int jsonIndent = BMCWEB_JSON_PRETTY_PRINT ? 2 : -1;
+
 enum class OpenCode
 {
     Success,
@@ -239,8 +246,7 @@ struct Response
         {
             return "";
         }
-        size_t hashval = std::hash<nlohmann::json>{}(jsonValue);
-        return "\"" + intToHexString(hashval, 8) + "\"";
+        return etagFromHash(hashJson(jsonValue));
     }
 
     void write(std::string&& bodyPart)
@@ -284,6 +290,9 @@ struct Response
         return ret;
     }
 
+    // The etag is a hash of the application/json serialization of jsonValue,
+    // so it is the same regardless of which representation the client asked
+    // for, and matches computeEtag().
     void setHashAndHandleNotModified()
     {
         // Can only hash if we have content that's valid
@@ -291,14 +300,20 @@ struct Response
         {
             return;
         }
-        size_t hashval = std::hash<nlohmann::json>{}(jsonValue);
-        std::string hexVal = "\"" + intToHexString(hashval, 8) + "\"";
-        addHeader(http::field::etag, hexVal);
-        if (expectedHash && hexVal == *expectedHash)
+        setEtagAndHandleNotModified(hashJson(jsonValue));
+    }
+
+    // Same as above, for when the caller has already serialized jsonValue
+    // with jsonIndent.  Hashing the bytes avoids walking the tree again.
+    void setHashAndHandleNotModified(std::string_view serializedJson)
+    {
+        if (jsonValue.empty() || result() != http::status::ok)
         {
-            jsonValue = nullptr;
-            result(http::status::not_modified);
+            return;
         }
+        bmcweb::EtagHasher hasher;
+        hasher.update(serializedJson);
+        setEtagAndHandleNotModified(hasher.finish());
     }
 
     void setExpectedHash(std::string_view hash)
@@ -344,7 +359,60 @@ struct Response
         return true;
     }
 
+    static std::string etagFromHash(size_t hashval)
+    {
+        return "\"" + intToHexString(hashval, 8) + "\"";
+    }
+
+    // A gzip encoded body is a different representation, so it needs its own
+    // strong validator (RFC 9110 8.8.3).
+    static std::string gzipEtag(std::string_view etag)
+    {
+        if (etag.size() < 2 || !etag.ends_with('"'))
+        {
+            return std::string(etag);
+        }
+        std::string gzip(etag.substr(0, etag.size() - 1));
+        gzip += "-gzip\"";
+        return gzip;
+    }
+
+    // True if candidate names this content in any of the encodings it is
+    // served in.
+    static bool etagMatches(std::string_view candidate, std::string_view etag)
+    {
+        return candidate == etag || candidate == gzipEtag(etag);
+    }
+
   private:
+    // Serializes in bounded chunks purely to hash the output, so computing an
+    // etag never needs the whole document in memory.
+    static size_t hashJson(const nlohmann::json& json)
+    {
+        bmcweb::EtagHasher hasher;
+        bmcweb::JsonStreamSerializer serializer(json, jsonIndent);
+        while (!serializer.isDone())
+        {
+            hasher.update(serializer.next(bmcweb::EtagHasher::blockSize));
+        }
+        return hasher.finish();
+    }
+
+    void setEtagAndHandleNotModified(size_t hashval)
+    {
+        std::string hexVal = etagFromHash(hashval);
+        if (expectedHash && etagMatches(*expectedHash, hexVal))
+        {
+            // Echo the validator the client holds, which names the encoding
+            // it has cached
+            addHeader(http::field::etag, *expectedHash);
+            jsonValue = nullptr;
+            result(http::status::not_modified);
+            return;
+        }
+        addHeader(http::field::etag, hexVal);
+    }
+
     std::optional<std::string> expectedHash;
     bool completed = false;
     std::function<void(Response&)> completeRequestHandler;
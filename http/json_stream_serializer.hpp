@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bmcweb
+{
+
+// Serializes a json tree a piece at a time, so that a response body can be
+// written to the socket without first building the whole document as one
+// string.  The output is byte for byte identical to
+// json.dump(indent, ' ', true, error_handler_t::replace)
+//
+// Containers are walked here.  Integers, literals and strings with nothing to
+// escape are written directly, and every other scalar goes through the public
+// dump(), so nothing depends on nlohmann's detail namespace.
+class JsonStreamSerializer
+{
+  public:
+    // The json tree must outlive the serializer.
+    JsonStreamSerializer(const nlohmann::json& rootIn, int indentIn) :
+        root(rootIn), indent(indentIn)
+    {}
+
+    JsonStreamSerializer(const JsonStreamSerializer&) = delete;
+    JsonStreamSerializer(JsonStreamSerializer&&) = delete;
+    JsonStreamSerializer& operator=(const JsonStreamSerializer&) = delete;
+    JsonStreamSerializer& operator=(JsonStreamSerializer&&) = delete;
+    ~JsonStreamSerializer() = default;
+
+    // Appends at least minBytes of serialized output to the internal buffer,
+    // unless the document ends first.  Returns the buffered output, which
+    // remains valid until the next call to next().
+    std::string& next(size_t minBytes)
+    {
+        out.clear();
+        while (out.size() < minBytes && !isDone())
+        {
+            step();
+        }
+        return out;
+    }
+
+    bool isDone() const
+    {
+        return started && stack.empty();
+    }
+
+  private:
+    struct Frame
+    {
+        nlohmann::json::const_iterator it;
+        nlohmann::json::const_iterator end;
+        bool isObject = false;
+        bool first = true;
+    };
+
+    bool pretty() const
+    {
+        return indent >= 0;
+    }
+
+    void newline(size_t depth)
+    {
+        if (pretty())
+        {
+            out += '\n';
+            out.append(depth * static_cast<size_t>(indent), ' ');
+        }
+    }
+
+    void writeDumped(const nlohmann::json& value)
+    {
+        out += value.dump(-1, ' ', true,
+                          nlohmann::json::error_handler_t::replace);
+    }
+
+    void writeString(std::string_view str)
+    {
+        bool plain = std::ranges::all_of(str, [](char c) {
+            unsigned char u = static_cast<unsigned char>(c);
+            return u >= 0x20 && u < 0x7f && c != '"' && c != '\\';
+        });
+        if (!plain)
+        {
+            writeDumped(nlohmann::json(str));
+            return;
+        }
+        out += '"';
+        out += str;
+        out += '"';
+    }
+
+    template <typename Integer>
+    void writeInteger(Integer value)
+    {
+        std::array<char, 24> buf{};
+        std::to_chars_result result =
+            std::to_chars(buf.data(), buf.data() + buf.size(), value);
+        out.append(buf.data(), result.ptr);
+    }
+
+    void writeScalar(const nlohmann::json& value)
+    {
+        switch (value.type())
+        {
+            case nlohmann::json::value_t::null:
+                out += "null";
+                return;
+            case nlohmann::json::value_t::boolean:
+                out += value.get<bool>() ? "true" : "false";
+                return;
+            case nlohmann::json::value_t::string:
+                writeString(*value.get_ptr<const std::string*>());
+                return;
+            case nlohmann::json::value_t::number_integer:
+                writeInteger(value.get<int64_t>());
+                return;
+            case nlohmann::json::value_t::number_unsigned:
+                writeInteger(value.get<uint64_t>());
+                return;
+            default:
+                writeDumped(value);
+                return;
+        }
+    }
+
+    void writeValue(const nlohmann::json& value)
+    {
+        if (value.is_object() || value.is_array())
+        {
+            bool isObject = value.is_object();
+            if (value.empty())
+            {
+                out += isObject ? "{}" : "[]";
+                return;
+            }
+            out += isObject ? '{' : '[';
+            stack.emplace_back(Frame{value.cbegin(), value.cend(), isObject});
+            return;
+        }
+        writeScalar(value);
+    }
+
+    void step()
+    {
+        if (!started)
+        {
+            started = true;
+            writeValue(root);
+            return;
+        }
+        Frame& frame = stack.back();
+        if (frame.it == frame.end)
+        {
+            bool isObject = frame.isObject;
+            stack.pop_back();
+            newline(stack.size());
+            out += isObject ? '}' : ']';
+            return;
+        }
+        if (!frame.first)
+        {
+            out += ',';
+        }
+        frame.first = false;
+        newline(stack.size());
+
+        // The frame reference is invalidated if writeValue pushes a child,
+        // so advance the iterator first.
+        nlohmann::json::const_iterator current = frame.it;
+        ++frame.it;
+        if (frame.isObject)
+        {
+            writeString(current.key());
+            out += pretty() ? ": " : ":";
+        }
+        writeValue(*current);
+    }
+
+    const nlohmann::json& root;
+    int indent;
+    std::string out;
+    std::vector<Frame> stack;
+    bool started = false;
+};
+
+} // namespace bmcweb
@@ -10,6 +10,7 @@
 #include <cstddef>
 #include <cstdio>
 #include <format>
+#include <functional>
 #include <source_location>
 #include <string>
 #include <string_view>
@@ -95,6 +96,66 @@ inline crow::LogLevel& getBmcwebCurrentLoggingLevel()
     return level;
 }
 
+inline bool isLogLevelEnabled(crow::LogLevel level)
+{
+    return getBmcwebCurrentLoggingLevel() >= level;
+}
+
+// Lines are written into stdout's buffer.  Once a scheduler is installed,
+// stdout is flushed from a deferred task rather than after every line, so a
+// burst of lines logged while handling a request costs one write.  Errors and
+// anything logged without a scheduler are flushed straight away.
+class LogFlusher
+{
+  public:
+    using Scheduler = std::function<void(std::function<void()>&&)>;
+
+    static LogFlusher& getInstance()
+    {
+        static LogFlusher flusher;
+        return flusher;
+    }
+
+    void setScheduler(Scheduler&& schedulerIn)
+    {
+        flush();
+        scheduler = std::move(schedulerIn);
+    }
+
+    void lineWritten(bool urgent) noexcept
+    {
+        if (urgent || !scheduler)
+        {
+            flush();
+            return;
+        }
+        if (flushPending)
+        {
+            return;
+        }
+        flushPending = true;
+        try
+        {
+            scheduler([this]() { flush(); });
+        }
+        catch (...)
+        {
+            flush();
+        }
+    }
+
+    void flush() noexcept
+    {
+        flushPending = false;
+        // Intentionally ignore error return.
+        fflush(stdout);
+    }
+
+  private:
+    bool flushPending = false;
+    Scheduler scheduler;
+};
+
 struct FormatString
 {
     std::string_view str;
@@ -119,7 +180,7 @@ template <LogLevel level, typename... Args>
 inline void vlog(std::format_string<Args...>&& format, Args&&... args,
                  const std::source_location& loc) noexcept
 {
-    if (getBmcwebCurrentLoggingLevel() < level)
+    if (!isLogLevelEnabled(level))
     {
         return;
     }
@@ -151,7 +212,7 @@ inline void vlog(std::format_string<Args...>&& format, Args&&... args,
     // Intentionally ignore error return.
     fwrite(logLocation.data(), sizeof(std::string::value_type),
            logLocation.size(), stdout);
-    fflush(stdout);
+    LogFlusher::getInstance().lineWritten(level <= LogLevel::Error);
 }
 } // namespace crow
 
@@ -239,3 +300,33 @@ BMCWEB_LOG_INFO(std::format_string<Args...>, Args&&...)
 template <typename... Args>
 BMCWEB_LOG_DEBUG(std::format_string<Args...>, Args&&...)
     -> BMCWEB_LOG_DEBUG<Args...>;
+
+// The macros check the level before the arguments are evaluated, so a line
+// below the active level doesn't build its arguments at all.  They expand to
+// the class templates above.
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#define BMCWEB_LOG_CRITICAL(...)                                               \
+    if (!crow::isLogLevelEnabled(crow::LogLevel::Critical)) {}                 \
+    else                                                                       \
+        BMCWEB_LOG_CRITICAL(__VA_ARGS__)
+
+#define BMCWEB_LOG_ERROR(...)                                                  \
+    if (!crow::isLogLevelEnabled(crow::LogLevel::Error)) {}                    \
+    else                                                                       \
+        BMCWEB_LOG_ERROR(__VA_ARGS__)
+
+#define BMCWEB_LOG_WARNING(...)                                                \
+    if (!crow::isLogLevelEnabled(crow::LogLevel::Warning)) {}                  \
+    else                                                                       \
+        BMCWEB_LOG_WARNING(__VA_ARGS__)
+
+#define BMCWEB_LOG_INFO(...)                                                   \
+    if (!crow::isLogLevelEnabled(crow::LogLevel::Info)) {}                     \
+    else                                                                       \
+        BMCWEB_LOG_INFO(__VA_ARGS__)
+
+#define BMCWEB_LOG_DEBUG(...)                                                  \
+    if (!crow::isLogLevelEnabled(crow::LogLevel::Debug)) {}                    \
+    else                                                                       \
+        BMCWEB_LOG_DEBUG(__VA_ARGS__)
+// NOLINTEND(cppcoreguidelines-macro-usage)
@@ -19,6 +19,7 @@ extern "C"
 #include <openssl/asn1.h>
 #include <openssl/obj_mac.h>
 #include <openssl/objects.h>
+#include <openssl/ssl.h>
 #include <openssl/types.h>
 #include <openssl/x509.h>
 #include <openssl/x509_vfy.h>
@@ -197,6 +198,31 @@ std::string getUsernameFromCert(X509* cert)
     }
 }
 
+// Creates a session for the user named in an already verified client
+// certificate
+static std::shared_ptr<persistent_data::UserSession> sessionFromCert(
+    const boost::asio::ip::address& clientIp, X509* peerCert)
+{
+    if (X509_check_purpose(peerCert, X509_PURPOSE_SSL_CLIENT, 0) != 1)
+    {
+        BMCWEB_LOG_DEBUG(
+            "Chain does not allow certificate to be used for SSL client authentication");
+        return nullptr;
+    }
+
+    std::string sslUser = getUsernameFromCert(peerCert);
+    if (sslUser.empty())
+    {
+        BMCWEB_LOG_WARNING("Failed to get user from peer certificate");
+        return nullptr;
+    }
+
+    std::string unsupportedClientId;
+    return persistent_data::SessionStore::getInstance().generateUserSession(
+        sslUser, clientIp, unsupportedClientId,
+        persistent_data::SessionType::MutualTLS);
+}
+
 std::shared_ptr<persistent_data::UserSession> verifyMtlsUser(
     const boost::asio::ip::address& clientIp,
     boost::asio::ssl::verify_context& ctx)
@@ -245,22 +271,37 @@ std::shared_ptr<persistent_data::UserSession> verifyMtlsUser(
 
     BMCWEB_LOG_DEBUG("Certificate verification of final depth");
 
-    if (X509_check_purpose(peerCert, X509_PURPOSE_SSL_CLIENT, 0) != 1)
+    return sessionFromCert(clientIp, peerCert);
+}
+
+std::shared_ptr<persistent_data::UserSession> verifyResumedMtlsUser(
+    const boost::asio::ip::address& clientIp, SSL* ssl)
+{
+    // do nothing if TLS is disabled
+    if (!persistent_data::SessionStore::getInstance()
+             .getAuthMethodsConfig()
+             .tls)
     {
-        BMCWEB_LOG_DEBUG(
-            "Chain does not allow certificate to be used for SSL client authentication");
+        BMCWEB_LOG_DEBUG("TLS auth_config is disabled");
         return nullptr;
     }
 
-    std::string sslUser = getUsernameFromCert(peerCert);
-    if (sslUser.empty())
+    X509* peerCert = SSL_get0_peer_certificate(ssl);
+    if (peerCert == nullptr)
     {
-        BMCWEB_LOG_WARNING("Failed to get user from peer certificate");
+        BMCWEB_LOG_DEBUG("Resumed TLS session has no client certificate.");
         return nullptr;
     }
 
-    std::string unsupportedClientId;
-    return persistent_data::SessionStore::getInstance().generateUserSession(
-        sslUser, clientIp, unsupportedClientId,
-        persistent_data::SessionType::MutualTLS);
+    // The chain isn't verified again on resumption, so rely on the result
+    // saved with the session when it was first established
+    long verifyResult = SSL_get_verify_result(ssl);
+    if (verifyResult != X509_V_OK)
+    {
+        BMCWEB_LOG_INFO("Resumed TLS session verify result is: {}",
+                        verifyResult);
+        return nullptr;
+    }
+
+    return sessionFromCert(clientIp, peerCert);
 }
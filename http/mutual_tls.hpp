@@ -4,6 +4,8 @@
 
 #include "sessions.hpp"
 
+#include <openssl/ssl.h>
+
 #include <boost/asio/ip/address.hpp>
 #include <boost/asio/ssl/verify_context.hpp>
 
@@ -12,3 +14,9 @@
 std::shared_ptr<persistent_data::UserSession> verifyMtlsUser(
     const boost::asio::ip::address& clientIp,
     boost::asio::ssl::verify_context& ctx);
+
+// Creates the session for a client whose TLS session was resumed, where the
+// verify callback isn't called again.  Uses the certificate and verify result
+// stored with the TLS session.
+std::shared_ptr<persistent_data::UserSession> verifyResumedMtlsUser(
+    const boost::asio::ip::address& clientIp, SSL* ssl);
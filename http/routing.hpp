@@ -10,12 +10,15 @@
 #include "routing/baserule.hpp"
 #include "routing/dynamicrule.hpp"
 #include "routing/taggedrule.hpp"
+#include "static_routes.hpp"
 #include "verb.hpp"
 
 #include <boost/beast/http/field.hpp>
 #include <boost/beast/http/status.hpp>
+#include <boost/beast/http/verb.hpp>
 #include <boost/container/flat_map.hpp>
 #include <boost/container/small_vector.hpp>
+#include <boost/container/static_vector.hpp>
 
 #include <algorithm>
 #include <array>
@@ -26,10 +29,10 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
-#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -42,6 +45,11 @@ class Trie
     struct Node
     {
         unsigned ruleIndex = 0U;
+        // Verbs with a rule at this node, and at this node or anywhere below
+        // it.  Lets a lookup skip subtrees that can't match a verb it still
+        // needs.
+        size_t methods = 0U;
+        size_t subtreeMethods = 0U;
 
         size_t stringParamChild = 0U;
         size_t pathParamChild = 0U;
@@ -155,22 +163,44 @@ class Trie
         findRouteIndexesHelper(reqUrl, routeIndexes, head());
     }
 
+    // Parameters are views into the url being matched, so matching doesn't
+    // allocate.  Rules take at most five parameters.
+    static constexpr size_t maxParams = 5;
+    using Params = boost::container::static_vector<std::string_view, maxParams>;
+
     struct FindResult
     {
-        unsigned ruleIndex;
-        std::vector<std::string> params;
+        // The first rule, in priority order, registered for the requested
+        // verb, or 0 if there isn't one
+        unsigned ruleIndex = 0U;
+        Params params;
+        // Every verb that has a rule matching the url
+        size_t methods = 0U;
     };
 
   private:
-    FindResult findHelper(const std::string_view reqUrl, const Node& node,
-                          std::vector<std::string>& params) const
+    void findHelper(std::string_view reqUrl, const Node& node, Params& params,
+                    size_t method, FindResult& result) const
     {
+        // Nothing under here can match a verb that hasn't been found already
+        if ((node.subtreeMethods & ~result.methods) == 0U)
+        {
+            return;
+        }
+
         if (reqUrl.empty())
         {
-            return {node.ruleIndex, params};
+            size_t found = node.methods & ~result.methods;
+            if ((found & method) != 0U)
+            {
+                result.ruleIndex = node.ruleIndex;
+                result.params = params;
+            }
+            result.methods |= found;
+            return;
         }
 
-        if (node.stringParamChild != 0U)
+        if (node.stringParamChild != 0U && params.size() < maxParams)
         {
             size_t epos = 0;
             for (; epos < reqUrl.size(); epos++)
@@ -184,24 +214,16 @@ class Trie
             if (epos != 0)
             {
                 params.emplace_back(reqUrl.substr(0, epos));
-                FindResult ret = findHelper(
-                    reqUrl.substr(epos), nodes[node.stringParamChild], params);
-                if (ret.ruleIndex != 0U)
-                {
-                    return {ret.ruleIndex, std::move(ret.params)};
-                }
+                findHelper(reqUrl.substr(epos), nodes[node.stringParamChild],
+                           params, method, result);
                 params.pop_back();
             }
         }
 
-        if (node.pathParamChild != 0U)
+        if (node.pathParamChild != 0U && params.size() < maxParams)
         {
             params.emplace_back(reqUrl);
-            FindResult ret = findHelper("", nodes[node.pathParamChild], params);
-            if (ret.ruleIndex != 0U)
-            {
-                return {ret.ruleIndex, std::move(ret.params)};
-            }
+            findHelper("", nodes[node.pathParamChild], params, method, result);
             params.pop_back();
         }
 
@@ -212,28 +234,31 @@ class Trie
 
             if (reqUrl.starts_with(fragment))
             {
-                FindResult ret =
-                    findHelper(reqUrl.substr(fragment.size()), child, params);
-                if (ret.ruleIndex != 0U)
-                {
-                    return {ret.ruleIndex, std::move(ret.params)};
-                }
+                findHelper(reqUrl.substr(fragment.size()), child, params,
+                           method, result);
             }
         }
-
-        return {0U, std::vector<std::string>()};
     }
 
   public:
-    FindResult find(const std::string_view reqUrl) const
+    // Matches reqUrl against the rules for every verb in one walk.  method is
+    // the bit of the verb whose rule is wanted.
+    FindResult find(std::string_view reqUrl, size_t method = 1U) const
     {
-        std::vector<std::string> start;
-        return findHelper(reqUrl, head(), start);
+        FindResult result;
+        Params params;
+        findHelper(reqUrl, head(), params, method, result);
+        return result;
     }
 
-    void add(std::string_view urlIn, unsigned ruleIndex)
+    // Adds urlIn for the verbs in methods.  Every verb registered at the same
+    // url shares one rule index, which is newRuleIndex when the url is new.
+    // Returns the url's rule index.
+    unsigned add(std::string_view urlIn, unsigned newRuleIndex,
+                 size_t methods = 1U)
     {
         size_t idx = 0;
+        nodes[idx].subtreeMethods |= methods;
 
         std::string_view url = urlIn;
 
@@ -262,6 +287,7 @@ class Trie
                         *param = newNode();
                     }
                     idx = *param;
+                    nodes[idx].subtreeMethods |= methods;
 
                     url.remove_prefix(str1.size());
                     break;
@@ -272,7 +298,7 @@ class Trie
                 }
 
                 BMCWEB_LOG_CRITICAL("Can't find tag for {}", urlIn);
-                return;
+                return 0U;
             }
             std::string piece(&c, 1);
             if (!nodes[idx].children.contains(piece))
@@ -281,16 +307,22 @@ class Trie
                 nodes[idx].children.emplace(piece, newNodeIdx);
             }
             idx = nodes[idx].children[piece];
+            nodes[idx].subtreeMethods |= methods;
             url.remove_prefix(1);
         }
         Node& node = nodes[idx];
-        if (node.ruleIndex != 0U)
+        if ((node.methods & methods) != 0U)
         {
             BMCWEB_LOG_CRITICAL("handler already exists for \"{}\"", urlIn);
             throw std::runtime_error(
                 std::format("handler already exists for \"{}\"", urlIn));
         }
-        node.ruleIndex = ruleIndex;
+        if (node.ruleIndex == 0U)
+        {
+            node.ruleIndex = newRuleIndex;
+        }
+        node.methods |= methods;
+        return node.ruleIndex;
     }
 
   private:
@@ -433,20 +465,96 @@ class Router
         }
     };
 
-    void internalAddRuleObject(const std::string& rule, BaseRule* ruleObject)
+    using RuleSet = std::array<BaseRule*, static_cast<size_t>(HttpVerb::Max)>;
+
+    // The normal routes for every verb share one trie.  Each url in it owns a
+    // RuleSet holding the rule registered for each verb, so a single walk
+    // finds both the rule to run and the verbs for the Allow header.
+    struct RouteTable
     {
-        if (ruleObject == nullptr)
+        std::vector<RuleSet> ruleSets;
+        Trie trie;
+        // rule index 0 has special meaning; preallocate it to avoid
+        // duplication.
+        RouteTable() : ruleSets(1) {}
+
+        void internalAdd(std::string_view rule, BaseRule* ruleObject,
+                         size_t methods)
         {
-            return;
+            addUrl(rule, ruleObject, methods);
+            // directory case:
+            //   request to `/about' url matches `/about/' rule
+            if (rule.size() > 2 && rule.back() == '/')
+            {
+                addUrl(rule.substr(0, rule.size() - 1), ruleObject, methods);
+            }
+        }
+
+      private:
+        void addUrl(std::string_view url, BaseRule* ruleObject,
+                    size_t methods)
+        {
+            unsigned index = trie.add(
+                url, static_cast<unsigned>(ruleSets.size()), methods);
+            if (index == 0U)
+            {
+                return;
+            }
+            if (index == ruleSets.size())
+            {
+                ruleSets.emplace_back();
+            }
+            for (size_t method = 0; method <= maxVerbIndex; method++)
+            {
+                if ((methods & (1U << method)) != 0U)
+                {
+                    ruleSets[index][method] = ruleObject;
+                }
+            }
         }
+    };
+
+    // The trie's answer for a url in the generated static route table, worked
+    // out once in validate()
+    struct StaticRoute
+    {
+        bool cached = false;
+        size_t methods = 0U;
+        RuleSet rules{};
+    };
+
+    void cacheStaticRoute(std::string_view url, StaticRoute& route) const
+    {
         for (size_t method = 0; method <= maxVerbIndex; method++)
         {
-            size_t methodBit = 1 << method;
-            if ((ruleObject->methodsBitfield & methodBit) > 0U)
+            Trie::FindResult found = routes.trie.find(url, 1U << method);
+            // A parameter route that wins over the static one needs its views
+            // into the request url, so leave the url to the trie
+            if (!found.params.empty())
             {
-                perMethods[method].internalAdd(rule, ruleObject);
+                return;
+            }
+            route.methods = found.methods;
+            if (found.ruleIndex != 0U)
+            {
+                route.rules[method] = routes.ruleSets[found.ruleIndex][method];
             }
         }
+        route.cached = true;
+    }
+
+    void internalAddRuleObject(const std::string& rule, BaseRule* ruleObject)
+    {
+        if (ruleObject == nullptr)
+        {
+            return;
+        }
+        size_t methods =
+            ruleObject->methodsBitfield & ((1U << (maxVerbIndex + 1)) - 1U);
+        if (methods != 0U)
+        {
+            routes.internalAdd(rule, ruleObject, methods);
+        }
 
         if (ruleObject->isNotFound)
         {
@@ -479,16 +587,19 @@ class Router
                 internalAddRuleObject(rule->rule, rule.get());
             }
         }
-        for (PerMethod& perMethod : perMethods)
+        routes.trie.validate();
+
+        staticRoutes.assign(static_routes::urls.size(), StaticRoute{});
+        for (size_t i = 0; i < static_routes::urls.size(); i++)
         {
-            perMethod.trie.validate();
+            cacheStaticRoute(static_routes::urls[i], staticRoutes[i]);
         }
     }
 
     struct FindRoute
     {
         BaseRule* rule = nullptr;
-        std::vector<std::string> params;
+        Trie::Params params;
     };
 
     struct FindRouteResponse
@@ -511,7 +622,41 @@ class Router
         if (found.ruleIndex != 0U)
         {
             route.rule = perMethod.rules[found.ruleIndex];
-            route.params = std::move(found.params);
+            route.params = found.params;
+        }
+        return route;
+    }
+
+    // Finds the rule for verbIndex, and every verb url has a rule for, in one
+    // walk of the route trie.  Urls in the static route table skip the walk.
+    FindRoute findRouteByVerb(std::string_view url, size_t verbIndex,
+                              size_t& methods) const
+    {
+        FindRoute route;
+
+        std::optional<size_t> staticIndex = static_routes::find(url);
+        if (staticIndex && *staticIndex < staticRoutes.size() &&
+            staticRoutes[*staticIndex].cached)
+        {
+            const StaticRoute& cached = staticRoutes[*staticIndex];
+            methods = cached.methods;
+            if (verbIndex <= maxVerbIndex)
+            {
+                route.rule = cached.rules[verbIndex];
+            }
+            return route;
+        }
+
+        Trie::FindResult found = routes.trie.find(url, 1U << verbIndex);
+        methods = found.methods;
+        if (found.ruleIndex >= routes.ruleSets.size())
+        {
+            throw std::runtime_error("Trie internal structure corrupted!");
+        }
+        if (found.ruleIndex != 0U && verbIndex <= maxVerbIndex)
+        {
+            route.rule = routes.ruleSets[found.ruleIndex][verbIndex];
+            route.params = found.params;
         }
         return route;
     }
@@ -520,16 +665,23 @@ class Router
     {
         FindRouteResponse findRoute;
 
-        // Check to see if this url exists at any verb
-        for (size_t perMethodIndex = 0; perMethodIndex <= maxVerbIndex;
-             perMethodIndex++)
+        // Unknown verbs still get an Allow header listing the ones that would
+        // have matched
+        size_t reqMethodIndex = maxVerbIndex + 1;
+        std::optional<HttpVerb> verb = httpVerbFromBoost(req.method());
+        if (verb)
         {
-            // Make sure it's safe to deference the array at that index
-            static_assert(
-                maxVerbIndex < std::tuple_size_v<decltype(perMethods)>);
-            FindRoute route = findRouteByPerMethod(req.url().encoded_path(),
-                                                   perMethods[perMethodIndex]);
-            if (route.rule == nullptr)
+            reqMethodIndex = static_cast<size_t>(*verb);
+        }
+
+        size_t methods = 0U;
+        FindRoute route =
+            findRouteByVerb(req.url().encoded_path(), reqMethodIndex, methods);
+
+        for (size_t methodIndex = 0; methodIndex <= maxVerbIndex;
+             methodIndex++)
+        {
+            if ((methods & (1U << methodIndex)) == 0U)
             {
                 continue;
             }
@@ -537,23 +689,10 @@ class Router
             {
                 findRoute.allowHeader += ", ";
             }
-            HttpVerb thisVerb = static_cast<HttpVerb>(perMethodIndex);
+            HttpVerb thisVerb = static_cast<HttpVerb>(methodIndex);
             findRoute.allowHeader += httpVerbToString(thisVerb);
         }
 
-        std::optional<HttpVerb> verb = httpVerbFromBoost(req.method());
-        if (!verb)
-        {
-            return findRoute;
-        }
-        size_t reqMethodIndex = static_cast<size_t>(*verb);
-        if (reqMethodIndex >= perMethods.size())
-        {
-            return findRoute;
-        }
-
-        FindRoute route = findRouteByPerMethod(req.url().encoded_path(),
-                                               perMethods[reqMethodIndex]);
         if (route.rule != nullptr)
         {
             findRoute.route = route;
@@ -562,6 +701,22 @@ class Router
         return findRoute;
     }
 
+    // Checked once the headers are read, so the body can be written straight
+    // to a file for the routes that asked for it
+    bool streamsBodyToFile(boost::beast::http::verb method,
+                           std::string_view path) const
+    {
+        std::optional<HttpVerb> verb = httpVerbFromBoost(method);
+        if (!verb)
+        {
+            return false;
+        }
+        size_t methods = 0U;
+        FindRoute route =
+            findRouteByVerb(path, static_cast<size_t>(*verb), methods);
+        return route.rule != nullptr && route.rule->streamsBodyToFile;
+    }
+
     template <typename Adaptor>
     void handleUpgrade(const std::shared_ptr<Request>& req,
                        const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
@@ -646,50 +801,54 @@ class Router
         }
 
         BaseRule& rule = *foundRoute.route.rule;
-        std::vector<std::string> params = std::move(foundRoute.route.params);
+        // Views into the url of req, which the lambda below keeps alive
+        Trie::Params params = foundRoute.route.params;
 
         BMCWEB_LOG_DEBUG("Matched rule '{}' {} / {}", rule.rule,
                          req->methodString(), rule.getMethods());
 
         if (req->session == nullptr)
         {
-            rule.handle(*req, asyncResp, params);
+            rule.handle(*req, asyncResp,
+                        std::span(params.data(), params.size()));
             return;
         }
         validatePrivilege(
             req, asyncResp, rule,
-            [req, asyncResp, &rule, params = std::move(params)]() {
-                rule.handle(*req, asyncResp, params);
+            [req, asyncResp, &rule, params]() {
+                rule.handle(*req, asyncResp,
+                            std::span(params.data(), params.size()));
             });
     }
 
     void debugPrint()
     {
-        for (size_t i = 0; i < perMethods.size(); i++)
-        {
-            BMCWEB_LOG_DEBUG("{}", httpVerbToString(static_cast<HttpVerb>(i)));
-            perMethods[i].trie.debugPrint();
-        }
+        routes.trie.debugPrint();
     }
 
     std::vector<const std::string*> getRoutes(const std::string& parent)
     {
         std::vector<const std::string*> ret;
 
-        for (const PerMethod& pm : perMethods)
+        std::vector<unsigned> x;
+        routes.trie.findRouteIndexes(parent, x);
+        for (unsigned index : x)
         {
-            std::vector<unsigned> x;
-            pm.trie.findRouteIndexes(parent, x);
-            for (unsigned index : x)
+            for (const BaseRule* rule : routes.ruleSets[index])
             {
-                ret.push_back(&pm.rules[index]->rule);
+                if (rule != nullptr)
+                {
+                    ret.push_back(&rule->rule);
+                }
             }
         }
         return ret;
     }
 
   private:
-    std::array<PerMethod, static_cast<size_t>(HttpVerb::Max)> perMethods;
+    RouteTable routes;
+    // Indexed like static_routes::urls
+    std::vector<StaticRoute> staticRoutes;
 
     PerMethod notFoundRoutes;
     PerMethod upgradeRoutes;
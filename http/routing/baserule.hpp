@@ -14,7 +14,9 @@
 #include <cstddef>
 #include <limits>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -44,7 +46,7 @@ class BaseRule
 
     virtual void handle(const Request& /*req*/,
                         const std::shared_ptr<bmcweb::AsyncResp>&,
-                        const std::vector<std::string>&) = 0;
+                        std::span<const std::string_view>) = 0;
     virtual void handleUpgrade(
         const Request& /*req*/,
         const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
@@ -93,6 +95,9 @@ class BaseRule
     bool isNotFound = false;
     bool isMethodNotAllowed = false;
     bool isUpgrade = false;
+    // Request bodies are written to a file as they arrive instead of being
+    // held in memory.  See Request::bodyFd()
+    bool streamsBodyToFile = false;
 
     std::vector<redfish::Privileges> privilegesSet;
 
@@ -11,10 +11,11 @@
 
 #include <functional>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
-#include <vector>
 
 namespace crow
 {
@@ -34,7 +35,7 @@ struct Wrapped<Func, std::tuple<ArgsWrapped...>>
 
     void operator()(const Request& req,
                     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                    const std::vector<std::string>& params)
+                    std::span<const std::string_view> params)
     {
         if constexpr (sizeof...(ArgsWrapped) == 2)
         {
@@ -42,24 +43,29 @@ struct Wrapped<Func, std::tuple<ArgsWrapped...>>
         }
         else if constexpr (sizeof...(ArgsWrapped) == 3)
         {
-            handler(req, asyncResp, params[0]);
+            handler(req, asyncResp, std::string(params[0]));
         }
         else if constexpr (sizeof...(ArgsWrapped) == 4)
         {
-            handler(req, asyncResp, params[0], params[1]);
+            handler(req, asyncResp, std::string(params[0]),
+                    std::string(params[1]));
         }
         else if constexpr (sizeof...(ArgsWrapped) == 5)
         {
-            handler(req, asyncResp, params[0], params[1], params[2]);
+            handler(req, asyncResp, std::string(params[0]),
+                    std::string(params[1]), std::string(params[2]));
         }
         else if constexpr (sizeof...(ArgsWrapped) == 6)
         {
-            handler(req, asyncResp, params[0], params[1], params[2], params[3]);
+            handler(req, asyncResp, std::string(params[0]),
+                    std::string(params[1]), std::string(params[2]),
+                    std::string(params[3]));
         }
         else if constexpr (sizeof...(ArgsWrapped) == 7)
         {
-            handler(req, asyncResp, params[0], params[1], params[2], params[3],
-                    params[4]);
+            handler(req, asyncResp, std::string(params[0]),
+                    std::string(params[1]), std::string(params[2]),
+                    std::string(params[3]), std::string(params[4]));
         }
     }
 };
@@ -80,7 +86,7 @@ class DynamicRule : public BaseRule, public RuleParameterTraits<DynamicRule>
 
     void handle(const Request& req,
                 const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                const std::vector<std::string>& params) override
+                std::span<const std::string_view> params) override
     {
         erasedHandler(req, asyncResp, params);
     }
@@ -95,7 +101,7 @@ class DynamicRule : public BaseRule, public RuleParameterTraits<DynamicRule>
   private:
     std::function<void(const Request&,
                        const std::shared_ptr<bmcweb::AsyncResp>&,
-                       const std::vector<std::string>&)>
+                       std::span<const std::string_view>)>
         erasedHandler;
 };
 
@@ -82,6 +82,15 @@ struct RuleParameterTraits
         return *self;
     }
 
+    // For routes taking large uploads, receive the body into a file rather
+    // than a string
+    self_t& streamBodyToFile()
+    {
+        self_t* self = static_cast<self_t*>(this);
+        self->streamsBodyToFile = true;
+        return *self;
+    }
+
     self_t& privileges(
         const std::initializer_list<std::initializer_list<const char*>>& p)
     {
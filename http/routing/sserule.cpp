@@ -15,9 +15,10 @@
 #include <boost/beast/http/status.hpp>
 
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 #include <utility>
-#include <vector>
 
 namespace crow
 {
@@ -33,7 +34,7 @@ void SseSocketRule::validate() {}
 
 void SseSocketRule::handle(const Request& /*req*/,
                            const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                           const std::vector<std::string>& /*params*/)
+                           std::span<const std::string_view> /*params*/)
 {
     BMCWEB_LOG_ERROR(
         "Handle called on websocket rule.  This should never happen");
@@ -8,10 +8,11 @@
 
 #include <functional>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
-#include <vector>
 
 namespace crow
 {
@@ -52,7 +53,7 @@ class TaggedRule :
 
     void handle(const Request& req,
                 const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                const std::vector<std::string>& params) override
+                std::span<const std::string_view> params) override
     {
         if constexpr (sizeof...(Args) == 0)
         {
@@ -60,24 +61,29 @@ class TaggedRule :
         }
         else if constexpr (sizeof...(Args) == 1)
         {
-            handler(req, asyncResp, params[0]);
+            handler(req, asyncResp, std::string(params[0]));
         }
         else if constexpr (sizeof...(Args) == 2)
         {
-            handler(req, asyncResp, params[0], params[1]);
+            handler(req, asyncResp, std::string(params[0]),
+                    std::string(params[1]));
         }
         else if constexpr (sizeof...(Args) == 3)
         {
-            handler(req, asyncResp, params[0], params[1], params[2]);
+            handler(req, asyncResp, std::string(params[0]),
+                    std::string(params[1]), std::string(params[2]));
         }
         else if constexpr (sizeof...(Args) == 4)
         {
-            handler(req, asyncResp, params[0], params[1], params[2], params[3]);
+            handler(req, asyncResp, std::string(params[0]),
+                    std::string(params[1]), std::string(params[2]),
+                    std::string(params[3]));
         }
         else if constexpr (sizeof...(Args) == 5)
         {
-            handler(req, asyncResp, params[0], params[1], params[2], params[3],
-                    params[4]);
+            handler(req, asyncResp, std::string(params[0]),
+                    std::string(params[1]), std::string(params[2]),
+                    std::string(params[3]), std::string(params[4]));
         }
         static_assert(sizeof...(Args) <= 5, "More args than are supported");
     }
@@ -14,9 +14,9 @@
 
 #include <functional>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
-#include <vector>
 
 namespace crow
 {
@@ -36,7 +36,7 @@ class WebSocketRule : public BaseRule
 
     void handle(const Request& /*req*/,
                 const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                const std::vector<std::string>& /*params*/) override
+                std::span<const std::string_view> /*params*/) override
     {
         BMCWEB_LOG_ERROR(
             "Handle called on websocket rule.  This should never happen");
@@ -53,6 +53,14 @@ class WebSocketRule : public BaseRule
                        boost::asio::ssl::stream<boost::asio::ip::tcp::socket>&&
                            adaptor) override;
 
+    // Offer permessage-deflate (RFC 7692) to clients on this route.  Worth it
+    // for text streams; data that is already compressed only costs CPU.
+    self_t& permessageDeflate()
+    {
+        deflate = true;
+        return *this;
+    }
+
     template <typename Func>
     self_t& onopen(Func f)
     {
@@ -99,5 +107,6 @@ class WebSocketRule : public BaseRule
     std::function<void(crow::websocket::Connection&, const std::string&)>
         closeHandler;
     std::function<void(crow::websocket::Connection&)> errorHandler;
+    bool deflate = false;
 };
 } // namespace crow
@@ -5,6 +5,7 @@
 
 #include <boost/beast/http/write.hpp>
 
+#include <functional>
 #include <memory>
 #include <string_view>
 
@@ -26,6 +27,9 @@ struct Connection : public std::enable_shared_from_this<Connection>
 
     virtual void close(std::string_view msg = "quit") = 0;
     virtual void sendSseEvent(std::string_view id, std::string_view msg) = 0;
+    // Calls handler once everything sent so far has been written to the
+    // socket, so large amounts of data can be sent without buffering it all
+    virtual void onDrain(std::function<void()> handler) = 0;
 };
 } // namespace sse_socket
 } // namespace crow
@@ -10,6 +10,7 @@
 
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/beast/core/error.hpp>
 #include <boost/beast/core/multi_buffer.hpp>
@@ -172,9 +173,38 @@ class ConnectionImpl : public Connection
         BMCWEB_LOG_DEBUG("async_write_some() bytes transferred: {}",
                          bytesTransferred);
 
+        if (inputBuffer.size() == 0 && drainHandler)
+        {
+            std::function<void()> handler = std::move(drainHandler);
+            drainHandler = nullptr;
+            handler();
+        }
         doWrite();
     }
 
+    void onDrain(std::function<void()> handler) override
+    {
+        drainHandler = std::move(handler);
+        if (doingWrite || inputBuffer.size() != 0)
+        {
+            return;
+        }
+        boost::asio::post(getIoContext(),
+                          std::bind_front(&ConnectionImpl::afterDrain, this,
+                                          shared_from_this()));
+    }
+
+    void afterDrain(const std::shared_ptr<Connection>& /*self*/)
+    {
+        if (doingWrite || inputBuffer.size() != 0 || !drainHandler)
+        {
+            return;
+        }
+        std::function<void()> handler = std::move(drainHandler);
+        drainHandler = nullptr;
+        handler();
+    }
+
     void sendSseEvent(std::string_view id, std::string_view msg) override
     {
         if (msg.empty())
@@ -271,6 +301,7 @@ class ConnectionImpl : public Connection
 
     std::function<void(Connection&, const Request&)> openHandler;
     std::function<void(Connection&)> closeHandler;
+    std::function<void()> drainHandler;
 };
 } // namespace sse_socket
 } // namespace crow
@@ -4,7 +4,9 @@
 
 #include "bmcweb_config.h"
 
+#include <fcntl.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 #include <boost/url/segments_view.hpp>
 #include <boost/url/url.hpp>
@@ -14,6 +16,7 @@
 
 #include <array>
 #include <bit>
+#include <cerrno>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
@@ -510,6 +513,39 @@ inline void setPortDefaults(boost::urls::url& url)
     }
 }
 
+// Passes the contents of fd to sink a chunk at a time, from the start of the
+// file.  Each chunk is released from the file once sink has taken it, so a
+// large memfd upload is never held in memory twice.  Returns false if
+// reading fails or sink returns false.
+inline bool drainFile(int fd, const std::function<bool(std::string_view)>& sink)
+{
+    std::array<char, 64UL * 1024UL> chunk{};
+    off_t offset = 0;
+    while (true)
+    {
+        ssize_t size = pread(fd, chunk.data(), chunk.size(), offset);
+        if (size < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        if (size == 0)
+        {
+            return true;
+        }
+        if (!sink(std::string_view(chunk.data(), static_cast<size_t>(size))))
+        {
+            return false;
+        }
+        // Best effort, the pages are freed with the file otherwise
+        fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset, size);
+        offset += size;
+    }
+}
+
 } // namespace utility
 } // namespace crow
 
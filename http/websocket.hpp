@@ -32,9 +32,13 @@ struct Connection : std::enable_shared_from_this<Connection>
     virtual const std::string& getUserName() const = 0;
 
     virtual void sendBinary(std::string_view msg) = 0;
+    // Queues msg without copying it.  The same message can be queued on any
+    // number of connections.
+    virtual void sendBinary(std::shared_ptr<const std::string> msg) = 0;
     virtual void sendEx(MessageType type, std::string_view msg,
                         std::function<void()>&& onDone) = 0;
     virtual void sendText(std::string_view msg) = 0;
+    virtual void sendText(std::shared_ptr<const std::string> msg) = 0;
     virtual void close(std::string_view msg = "quit") = 0;
     virtual void deferRead() = 0;
     virtual void resumeRead() = 0;
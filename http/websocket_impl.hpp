@@ -15,12 +15,12 @@
 #include <boost/asio/error.hpp>
 #include <boost/asio/ssl/error.hpp>
 #include <boost/beast/core/error.hpp>
-#include <boost/beast/core/multi_buffer.hpp>
 #include <boost/beast/core/role.hpp>
 #include <boost/beast/http/field.hpp>
 #include <boost/beast/http/message.hpp>
 #include <boost/beast/http/status.hpp>
 #include <boost/beast/websocket/error.hpp>
+#include <boost/beast/websocket/option.hpp>
 #include <boost/beast/websocket/rfc6455.hpp>
 #include <boost/beast/websocket/stream.hpp>
 #include <boost/beast/websocket/stream_base.hpp>
@@ -30,6 +30,7 @@
 #include <boost/beast/websocket/ssl.hpp>
 
 #include <cstddef>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <string>
@@ -58,7 +59,8 @@ class ConnectionImpl : public Connection
                            std::function<void()>&& whenComplete)>
             messageExHandlerIn,
         std::function<void(Connection&, const std::string&)> closeHandlerIn,
-        std::function<void(Connection&)> errorHandlerIn) :
+        std::function<void(Connection&)> errorHandlerIn,
+        bool permessageDeflate) :
         uri(urlViewIn), ws(std::move(adaptorIn)), inBuffer(inString, 131088),
         openHandler(std::move(openHandlerIn)),
         messageHandler(std::move(messageHandlerIn)),
@@ -69,6 +71,19 @@ class ConnectionImpl : public Connection
         /* Turn on the timeouts on websocket stream to server role */
         ws.set_option(boost::beast::websocket::stream_base::timeout::suggested(
             boost::beast::role_type::server));
+        if (permessageDeflate)
+        {
+            boost::beast::websocket::permessage_deflate deflate;
+            deflate.server_enable = true;
+            // A 4KiB window bounds the zlib state held per connection, and
+            // still finds the repetition in console and JSON text
+            deflate.server_max_window_bits = 12;
+            deflate.client_max_window_bits = 12;
+            deflate.compLevel = 6;
+            // Single keystrokes and echoes aren't worth compressing
+            deflate.msg_size_threshold = 64;
+            ws.set_option(deflate);
+        }
         BMCWEB_LOG_DEBUG("Creating new connection {}", logPtr(this));
     }
 
@@ -132,9 +147,12 @@ class ConnectionImpl : public Connection
 
     void sendBinary(std::string_view msg) override
     {
-        ws.binary(true);
-        outBuffer.commit(boost::asio::buffer_copy(outBuffer.prepare(msg.size()),
-                                                  boost::asio::buffer(msg)));
+        sendBinary(std::make_shared<const std::string>(msg));
+    }
+
+    void sendBinary(std::shared_ptr<const std::string> msg) override
+    {
+        outQueue.push_back(OutMessage{std::move(msg), true});
         doWrite();
     }
 
@@ -175,9 +193,12 @@ class ConnectionImpl : public Connection
 
     void sendText(std::string_view msg) override
     {
-        ws.text(true);
-        outBuffer.commit(boost::asio::buffer_copy(outBuffer.prepare(msg.size()),
-                                                  boost::asio::buffer(msg)));
+        sendText(std::make_shared<const std::string>(msg));
+    }
+
+    void sendText(std::shared_ptr<const std::string> msg) override
+    {
+        outQueue.push_back(OutMessage{std::move(msg), false});
         doWrite();
     }
 
@@ -282,34 +303,48 @@ class ConnectionImpl : public Connection
             return;
         }
 
-        if (outBuffer.size() == 0)
+        if (outQueue.empty())
         {
             // Done for now
             return;
         }
         doingWrite = true;
-        ws.async_write(outBuffer.data(), [this, self(shared_from_this())](
-                                             const boost::beast::error_code& ec,
-                                             size_t bytesSent) {
-            doingWrite = false;
-            outBuffer.consume(bytesSent);
-            if (ec == boost::beast::websocket::error::closed)
-            {
-                // Do nothing here.  doRead handler will call the
-                // closeHandler.
-                close("Write error");
-                return;
-            }
-            if (ec)
-            {
-                BMCWEB_LOG_ERROR("Error in ws.async_write {}", ec);
-                return;
-            }
-            doWrite();
-        });
+        // Each queued message goes out as its own frame.  The queue keeps
+        // the message alive until the write completes.
+        const OutMessage& message = outQueue.front();
+        ws.binary(message.binary);
+        ws.async_write(boost::asio::buffer(*message.data),
+                       std::bind_front(&self_t::afterWrite, this,
+                                       shared_from_this()));
     }
 
   private:
+    struct OutMessage
+    {
+        std::shared_ptr<const std::string> data;
+        bool binary;
+    };
+
+    void afterWrite(const std::shared_ptr<Connection>& /*self*/,
+                    const boost::beast::error_code& ec, size_t /*bytesSent*/)
+    {
+        doingWrite = false;
+        outQueue.pop_front();
+        if (ec == boost::beast::websocket::error::closed)
+        {
+            // Do nothing here.  doRead handler will call the
+            // closeHandler.
+            close("Write error");
+            return;
+        }
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR("Error in ws.async_write {}", ec);
+            return;
+        }
+        doWrite();
+    }
+
     void handleMessage(size_t bytesRead)
     {
         if (messageExHandler)
@@ -351,7 +386,7 @@ class ConnectionImpl : public Connection
                                        std::string::allocator_type>
         inBuffer;
 
-    boost::beast::multi_buffer outBuffer;
+    std::deque<OutMessage> outQueue;
     bool doingWrite = false;
 
     std::function<void(Connection&)> openHandler;
@@ -11,14 +11,17 @@
 #include <boost/asio/ip/address_v4.hpp>
 #include <boost/asio/ip/address_v6.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/system/errc.hpp>
 
 #include <charconv>
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <string_view>
 #include <system_error>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace async_resolve
@@ -55,9 +58,9 @@ inline bool endpointFromResolveTuple(const std::vector<uint8_t>& ipAddress,
 class Resolver
 {
   public:
-    // unused io param used to keep interface identical to
+    // io param used to keep interface identical to
     // boost::asio::tcp:::resolver
-    explicit Resolver(boost::asio::io_context& /*io*/) {}
+    explicit Resolver(boost::asio::io_context& ioIn) : io(ioIn) {}
 
     ~Resolver() = default;
 
@@ -89,6 +92,20 @@ class Resolver
             return;
         }
 
+        // An address needs no lookup
+        boost::system::error_code addrEc;
+        boost::asio::ip::address addr =
+            boost::asio::ip::make_address(host, addrEc);
+        if (!addrEc)
+        {
+            boost::asio::ip::tcp::endpoint endpoint(addr, portNum);
+            boost::asio::post(
+                io, std::bind_front(std::forward<ResolveHandler>(handler),
+                                    boost::system::error_code(),
+                                    results_type{endpoint}));
+            return;
+        }
+
         uint64_t flag = 0;
         crow::connections::systemBus->async_method_call(
             [host{std::string(host)}, portNum,
@@ -130,6 +147,9 @@ class Resolver
             "org.freedesktop.resolve1.Manager", "ResolveHostname", 0, host,
             AF_UNSPEC, flag);
     }
+
+  private:
+    boost::asio::io_context& io;
 };
 
 } // namespace async_resolve
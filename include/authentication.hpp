@@ -4,6 +4,7 @@
 
 #include "bmcweb_config.h"
 
+#include "basic_auth_cache.hpp"
 #include "http_response.hpp"
 #include "logging.hpp"
 #include "ossl_random.hpp"
@@ -70,30 +71,30 @@ inline std::shared_ptr<persistent_data::UserSession> performBasicAuth(
     BMCWEB_LOG_DEBUG("[AuthMiddleware] User IPAddress: {}",
                      clientIp.to_string());
 
-    int pamrc = pamAuthenticateUser(user, pass, std::nullopt);
-    bool isConfigureSelfOnly = pamrc == PAM_NEW_AUTHTOK_REQD;
-    if ((pamrc != PAM_SUCCESS) && !isConfigureSelfOnly)
+    // Credentials PAM accepted moments ago don't need another PAM
+    // transaction.  Logins that must change their password are never cached.
+    bool isConfigureSelfOnly = false;
+    if (!BasicAuthCache::getInstance().verify(user, pass))
     {
-        return nullptr;
+        int pamrc = pamAuthenticateUser(user, pass, std::nullopt);
+        isConfigureSelfOnly = pamrc == PAM_NEW_AUTHTOK_REQD;
+        if ((pamrc != PAM_SUCCESS) && !isConfigureSelfOnly)
+        {
+            return nullptr;
+        }
+        if (pamrc == PAM_SUCCESS)
+        {
+            BasicAuthCache::getInstance().insert(user, pass);
+        }
     }
 
     // Attempt to locate an existing Basic Auth session from the same ip address
     // and user
-    for (auto& session :
-         persistent_data::SessionStore::getInstance().getSessions())
+    std::shared_ptr<persistent_data::UserSession> session =
+        persistent_data::SessionStore::getInstance().getBasicSession(
+            user, redfish::ip_util::toString(clientIp));
+    if (session != nullptr)
     {
-        if (session->sessionType != persistent_data::SessionType::Basic)
-        {
-            continue;
-        }
-        if (session->clientIp != redfish::ip_util::toString(clientIp))
-        {
-            continue;
-        }
-        if (session->username != user)
-        {
-            continue;
-        }
         return session;
     }
 
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include "logging.hpp"
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace crow
+{
+
+/**
+ * @brief Remembers Basic auth credentials that PAM recently accepted.
+ *
+ * A PAM transaction costs tens of milliseconds and blocks the io thread, and
+ * clients that only speak Basic auth send the same credentials with every
+ * request.  Passwords are never stored: each entry holds an HMAC-SHA256 of
+ * the username and password under a key drawn at startup, so the entries are
+ * useless without this process's memory.  Only successful logins are cached,
+ * so failed attempts still reach PAM and its lockout accounting.  Entries are
+ * dropped when user_monitor.hpp sees the user change, and when a password is
+ * set through the AccountService.
+ */
+class BasicAuthCache
+{
+  public:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::seconds defaultTimeToLive{30};
+    static constexpr std::size_t maxEntries = 64;
+
+    explicit BasicAuthCache(clock::duration timeToLiveIn = defaultTimeToLive) :
+        timeToLive(timeToLiveIn)
+    {
+        if (RAND_bytes(key.data(), static_cast<int>(key.size())) != 1)
+        {
+            BMCWEB_LOG_ERROR("Cannot get random key, Basic auth cache off");
+            return;
+        }
+        enabled = true;
+    }
+
+    ~BasicAuthCache()
+    {
+        OPENSSL_cleanse(key.data(), key.size());
+    }
+
+    BasicAuthCache(const BasicAuthCache&) = delete;
+    BasicAuthCache(BasicAuthCache&&) = delete;
+    BasicAuthCache& operator=(const BasicAuthCache&) = delete;
+    BasicAuthCache& operator=(BasicAuthCache&&) = delete;
+
+    static BasicAuthCache& getInstance()
+    {
+        static BasicAuthCache cache;
+        return cache;
+    }
+
+    // Returns true if these credentials were accepted by PAM within the time
+    // to live.
+    bool verify(const std::string& username, std::string_view password)
+    {
+        auto it = entries.find(username);
+        if (it == entries.end())
+        {
+            return false;
+        }
+        if (clock::now() >= it->second.expires)
+        {
+            entries.erase(it);
+            return false;
+        }
+        Digest digest{};
+        if (!computeDigest(username, password, digest))
+        {
+            return false;
+        }
+        bool match = CRYPTO_memcmp(digest.data(), it->second.digest.data(),
+                                   digest.size()) == 0;
+        OPENSSL_cleanse(digest.data(), digest.size());
+        return match;
+    }
+
+    void insert(const std::string& username, std::string_view password)
+    {
+        Digest digest{};
+        if (!computeDigest(username, password, digest))
+        {
+            return;
+        }
+        if (entries.size() >= maxEntries && !entries.contains(username))
+        {
+            removeExpired();
+            if (entries.size() >= maxEntries)
+            {
+                entries.clear();
+            }
+        }
+        entries.insert_or_assign(username,
+                                 Entry{digest, clock::now() + timeToLive});
+        OPENSSL_cleanse(digest.data(), digest.size());
+    }
+
+    void invalidate(const std::string& username)
+    {
+        entries.erase(username);
+    }
+
+    void clear()
+    {
+        entries.clear();
+    }
+
+  private:
+    using Digest = std::array<unsigned char, 32>;
+
+    struct Entry
+    {
+        Digest digest;
+        clock::time_point expires;
+    };
+
+    bool computeDigest(std::string_view username, std::string_view password,
+                       Digest& digest) const
+    {
+        if (!enabled)
+        {
+            return false;
+        }
+        // The separator keeps ("ab", "c") and ("a", "bc") apart
+        std::string message;
+        message.reserve(username.size() + 1 + password.size());
+        message += username;
+        message += '\0';
+        message += password;
+
+        unsigned int digestSize = 0;
+        const unsigned char* result = HMAC(
+            EVP_sha256(), key.data(), static_cast<int>(key.size()),
+            std::bit_cast<const unsigned char*>(message.data()),
+            message.size(), digest.data(), &digestSize);
+        OPENSSL_cleanse(message.data(), message.size());
+        return result != nullptr && digestSize == digest.size();
+    }
+
+    void removeExpired()
+    {
+        clock::time_point now = clock::now();
+        std::erase_if(entries, [now](const auto& entry) {
+            return now >= entry.second.expires;
+        });
+    }
+
+    std::array<unsigned char, 32> key{};
+    bool enabled = false;
+    clock::duration timeToLive;
+    std::unordered_map<std::string, Entry> entries;
+};
+
+} // namespace crow
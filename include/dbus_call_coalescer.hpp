@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include <boost/system/error_code.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dbus
+{
+namespace utility
+{
+
+/**
+ * @brief Shares one in-flight D-Bus read between callers asking for the same
+ * (service, path).
+ *
+ * Every call is tagged with the service's signal generation from
+ * DbusObjectCache when it is sent.  A caller only joins a call sent at the
+ * current generation.  Any change the service made since the call was sent,
+ * including one made by a write this caller is ordering itself after, was
+ * announced with a signal that bumped the generation, so the caller gets a
+ * fresh call instead of a reply that may predate the change.
+ */
+template <typename Result>
+class DbusCallCoalescer
+{
+  public:
+    using Callback =
+        std::function<void(const boost::system::error_code&, const Result&)>;
+    using Key = std::pair<std::string, std::string>;
+
+    struct Call
+    {
+        uint64_t generation = 0;
+        std::vector<Callback> callbacks;
+    };
+
+    // Adds callback to the call in flight for key, if there is one at this
+    // generation.  Otherwise returns a new call, which the caller must send
+    // and then pass to complete().
+    std::shared_ptr<Call> join(const Key& key, uint64_t generation,
+                               Callback&& callback)
+    {
+        auto it = inFlight.find(key);
+        if (it != inFlight.end() && it->second->generation == generation)
+        {
+            it->second->callbacks.emplace_back(std::move(callback));
+            return nullptr;
+        }
+        std::shared_ptr<Call> call = std::make_shared<Call>();
+        call->generation = generation;
+        call->callbacks.emplace_back(std::move(callback));
+        // A call from an older generation stays in flight, and still answers
+        // its own callers, but takes no new ones
+        inFlight.insert_or_assign(key, call);
+        return call;
+    }
+
+    void complete(const Key& key, const std::shared_ptr<Call>& call,
+                  const boost::system::error_code& ec, const Result& result)
+    {
+        auto it = inFlight.find(key);
+        if (it != inFlight.end() && it->second == call)
+        {
+            inFlight.erase(it);
+        }
+        for (const Callback& callback : call->callbacks)
+        {
+            callback(ec, result);
+        }
+    }
+
+    size_t size() const
+    {
+        return inFlight.size();
+    }
+
+  private:
+    std::map<Key, std::shared_ptr<Call>> inFlight;
+};
+
+} // namespace utility
+} // namespace dbus
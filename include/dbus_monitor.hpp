@@ -126,8 +126,8 @@ inline int onPropertyUpdate(sd_bus_message* m, void* userdata,
         return 0;
     }
 
-    connection->sendText(
-        json.dump(2, ' ', true, nlohmann::json::error_handler_t::replace));
+    connection->sendText(std::make_shared<const std::string>(
+        json.dump(2, ' ', true, nlohmann::json::error_handler_t::replace)));
     return 0;
 }
 
@@ -136,6 +136,7 @@ inline void requestRoutes(App& app)
     BMCWEB_ROUTE(app, "/subscribe")
         .privileges({{"Login"}})
         .websocket()
+        .permessageDeflate()
         .onopen([](crow::websocket::Connection& conn) {
             BMCWEB_LOG_DEBUG("Connection {} opened", logPtr(&conn));
             sessions.try_emplace(&conn);
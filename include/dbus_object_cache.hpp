@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace dbus
+{
+namespace utility
+{
+
+/**
+ * @brief Caches GetAll and GetManagedObjects replies, per service.
+ *
+ * The cache only stays coherent if every change to a cached service is
+ * announced with PropertiesChanged, InterfacesAdded or InterfacesRemoved.
+ * The owner of the cache is expected to subscribe to those signals, and to
+ * NameOwnerChanged, and call invalidateService() for each of them.  Entries
+ * are dropped a whole service at a time.
+ */
+class DbusObjectCache
+{
+  public:
+    // Upper bound on the number of cached properties, across all services.
+    // Used as a proxy for memory use.
+    static constexpr size_t maxProperties = 20000;
+
+    static DbusObjectCache& getInstance()
+    {
+        static DbusObjectCache cache;
+        return cache;
+    }
+
+    std::shared_ptr<const DBusPropertiesMap> findProperties(
+        const std::string& service, const std::string& path,
+        const std::string& interface)
+    {
+        auto serviceIt = services.find(service);
+        if (serviceIt != services.end())
+        {
+            auto it = serviceIt->second.properties.find({path, interface});
+            if (it != serviceIt->second.properties.end())
+            {
+                hits++;
+                return it->second;
+            }
+        }
+        misses++;
+        return nullptr;
+    }
+
+    std::shared_ptr<const ManagedObjectType> findManagedObjects(
+        const std::string& service, const std::string& path)
+    {
+        auto serviceIt = services.find(service);
+        if (serviceIt != services.end())
+        {
+            auto it = serviceIt->second.managedObjects.find(path);
+            if (it != serviceIt->second.managedObjects.end())
+            {
+                hits++;
+                return it->second;
+            }
+        }
+        misses++;
+        return nullptr;
+    }
+
+    // Callers capture the generation before issuing the D-Bus call, and pass
+    // it back on insert, so a reply that raced with an invalidation of the
+    // service is never cached.
+    uint64_t getGeneration(const std::string& service)
+    {
+        return services[service].generation;
+    }
+
+    void insertProperties(const std::string& service, const std::string& path,
+                          const std::string& interface,
+                          const DBusPropertiesMap& properties,
+                          uint64_t generation)
+    {
+        Service* entry = prepareInsert(service, generation, properties.size());
+        if (entry == nullptr)
+        {
+            return;
+        }
+        entry->properties.insert_or_assign(
+            std::make_tuple(path, interface),
+            std::make_shared<const DBusPropertiesMap>(properties));
+    }
+
+    void insertManagedObjects(const std::string& service,
+                              const std::string& path,
+                              const ManagedObjectType& objects,
+                              uint64_t generation)
+    {
+        size_t count = 0;
+        for (const auto& [objectPath, interfaces] : objects)
+        {
+            for (const auto& [interface, properties] : interfaces)
+            {
+                count += properties.size();
+            }
+        }
+        Service* entry = prepareInsert(service, generation, count);
+        if (entry == nullptr)
+        {
+            return;
+        }
+        entry->managedObjects.insert_or_assign(
+            path, std::make_shared<const ManagedObjectType>(objects));
+    }
+
+    void invalidateService(const std::string& service)
+    {
+        auto it = services.find(service);
+        if (it == services.end())
+        {
+            return;
+        }
+        Service& entry = it->second;
+        propertyCount -= entry.propertyCount;
+        entry.propertyCount = 0;
+        entry.properties.clear();
+        entry.managedObjects.clear();
+        entry.generation++;
+    }
+
+    void clear()
+    {
+        for (auto& [service, entry] : services)
+        {
+            entry.propertyCount = 0;
+            entry.properties.clear();
+            entry.managedObjects.clear();
+            entry.generation++;
+        }
+        propertyCount = 0;
+    }
+
+    size_t size() const
+    {
+        return propertyCount;
+    }
+
+    uint64_t getHits() const
+    {
+        return hits;
+    }
+
+    uint64_t getMisses() const
+    {
+        return misses;
+    }
+
+    double getHitRatio() const
+    {
+        uint64_t total = hits + misses;
+        if (total == 0)
+        {
+            return 0.0;
+        }
+        return static_cast<double>(hits) / static_cast<double>(total);
+    }
+
+  private:
+    struct Service
+    {
+        uint64_t generation = 0;
+        size_t propertyCount = 0;
+        std::map<std::tuple<std::string, std::string>,
+                 std::shared_ptr<const DBusPropertiesMap>>
+            properties;
+        std::map<std::string, std::shared_ptr<const ManagedObjectType>>
+            managedObjects;
+    };
+
+    Service* prepareInsert(const std::string& service, uint64_t generation,
+                           size_t count)
+    {
+        auto it = services.find(service);
+        if (it == services.end() || it->second.generation != generation)
+        {
+            BMCWEB_LOG_DEBUG("Not caching stale reply from {}", service);
+            return nullptr;
+        }
+        if (count > maxProperties)
+        {
+            return nullptr;
+        }
+        if (propertyCount + count > maxProperties)
+        {
+            BMCWEB_LOG_DEBUG("D-Bus cache full, clearing");
+            clear();
+        }
+        it->second.propertyCount += count;
+        propertyCount += count;
+        return &it->second;
+    }
+
+    std::map<std::string, Service, std::less<>> services;
+    size_t propertyCount = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+};
+
+} // namespace utility
+} // namespace dbus
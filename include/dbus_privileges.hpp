@@ -12,12 +12,14 @@
 #include "privileges.hpp"
 #include "routing/baserule.hpp"
 #include "sessions.hpp"
+#include "user_info_cache.hpp"
 #include "utils/dbus_utils.hpp"
 
 #include <boost/beast/http/status.hpp>
 #include <boost/url/format.hpp>
 #include <sdbusplus/unpack_properties.hpp>
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -156,8 +158,9 @@ inline void requestUserInfo(
     std::move_only_function<void(const dbus::utility::DBusPropertiesMap&)>&&
         callback)
 {
+    uint64_t generation = UserInfoCache::getInstance().getGeneration();
     crow::connections::systemBus->async_method_call(
-        [asyncResp, callback = std::move(callback)](
+        [asyncResp, username, generation, callback = std::move(callback)](
             const boost::system::error_code& ec,
             const dbus::utility::DBusPropertiesMap& userInfoMap) mutable {
             if (ec)
@@ -167,6 +170,8 @@ inline void requestUserInfo(
                     boost::beast::http::status::internal_server_error);
                 return;
             }
+            UserInfoCache::getInstance().insert(username, userInfoMap,
+                                                generation);
             callback(userInfoMap);
         },
         "xyz.openbmc_project.User.Manager", "/xyz/openbmc_project/user",
@@ -183,6 +188,18 @@ inline void validatePrivilege(
         return;
     }
 
+    // On a cache hit, validate synchronously and skip the D-Bus round trip
+    const dbus::utility::DBusPropertiesMap* cachedUserInfo =
+        UserInfoCache::getInstance().find(req->session->username);
+    if (cachedUserInfo != nullptr)
+    {
+        if (afterGetUserInfoValidate(*req, asyncResp, rule, *cachedUserInfo))
+        {
+            callback();
+        }
+        return;
+    }
+
     requestUserInfo(
         req->session->username, asyncResp,
         [req, asyncResp, &rule, callback = std::move(callback)](
@@ -42,6 +42,10 @@ struct UserSubscription
     boost::beast::http::fields httpHeaders;
     std::vector<std::string> metricReportDefinitions;
     std::vector<std::string> originResources;
+    // Event batch window set through Oem.OpenBMC, which overrides the
+    // event-batch-window-ms build option.  Same range as the option.
+    static constexpr uint64_t maxBatchWindowMs = 10000;
+    std::optional<uint64_t> batchWindowMs;
 
     static std::optional<UserSubscription> fromJson(
         const nlohmann::json::object_t& j, const bool loadFromOldConfig = false)
@@ -123,6 +127,16 @@ struct UserSubscription
                 }
                 subvalue.hbIntervalMinutes = *value;
             }
+            else if (element.first == "BatchWindowMilliseconds")
+            {
+                const uint64_t* value =
+                    element.second.get_ptr<const uint64_t*>();
+                if (value == nullptr || *value > maxBatchWindowMs)
+                {
+                    continue;
+                }
+                subvalue.batchWindowMs = *value;
+            }
             else if (element.first == "Context")
             {
                 const std::string* value =
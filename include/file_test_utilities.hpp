@@ -7,6 +7,7 @@
 #include <filesystem>
 #include <string>
 #include <string_view>
+#include <system_error>
 
 #include <gtest/gtest.h>
 
@@ -41,3 +42,39 @@ struct TemporaryFileHandle
         std::filesystem::remove(path);
     }
 };
+
+struct TemporaryDirectory
+{
+    std::filesystem::path path;
+
+    // Creates an empty directory whose name starts with prefix, removes it
+    // and everything in it on destruction.  path is left empty if the
+    // directory couldn't be created.
+    explicit TemporaryDirectory(std::string_view prefix)
+    {
+        std::string stringPath = (std::filesystem::temp_directory_path() /
+                                  (std::string(prefix) + "_XXXXXX"))
+                                     .string();
+        // NOLINTNEXTLINE(misc-include-cleaner)
+        if (mkdtemp(stringPath.data()) == nullptr)
+        {
+            ADD_FAILURE() << "Failed to create " << stringPath;
+            return;
+        }
+        path = stringPath;
+    }
+
+    TemporaryDirectory(const TemporaryDirectory&) = delete;
+    TemporaryDirectory(TemporaryDirectory&&) = delete;
+    TemporaryDirectory& operator=(const TemporaryDirectory&) = delete;
+    TemporaryDirectory& operator=(TemporaryDirectory&&) = delete;
+
+    ~TemporaryDirectory()
+    {
+        if (!path.empty())
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(path, ec);
+        }
+    }
+};
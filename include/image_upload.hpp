@@ -111,7 +111,10 @@ inline void uploadImageHandler(
     BMCWEB_LOG_DEBUG("Writing file to {}", filepath);
     std::ofstream out(filepath, std::ofstream::out | std::ofstream::binary |
                                     std::ofstream::trunc);
-    out << req.body();
+    if (!req.drainBodyTo(out))
+    {
+        BMCWEB_LOG_ERROR("Failed to write image to {}", filepath);
+    }
     out.close();
     timeout.async_wait(timeoutHandler);
 }
@@ -120,6 +123,7 @@ inline void requestRoutes(App& app)
 {
     BMCWEB_ROUTE(app, "/upload/image/<str>")
         .privileges({{"ConfigureComponents", "ConfigureManager"}})
+        .streamBodyToFile()
         .methods(boost::beast::http::verb::post, boost::beast::http::verb::put)(
             [](const crow::Request& req,
                const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
@@ -127,6 +131,7 @@ inline void requestRoutes(App& app)
 
     BMCWEB_ROUTE(app, "/upload/image")
         .privileges({{"ConfigureComponents", "ConfigureManager"}})
+        .streamBodyToFile()
         .methods(boost::beast::http::verb::post, boost::beast::http::verb::put)(
             [](const crow::Request& req,
                const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
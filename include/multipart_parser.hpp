@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <functional>
 #include <ranges>
 #include <string>
 #include <string_view>
@@ -63,10 +64,34 @@ class MultipartParser
   public:
     MultipartParser() = default;
 
+    // Parses a whole request.  Bodies received into a file are read back a
+    // chunk at a time, so they are never held in memory in full.
     [[nodiscard]] ParserError parse(const crow::Request& req)
     {
-        std::string_view contentType = req.getHeaderValue("content-type");
+        ParserError ec = start(req.getHeaderValue("content-type"));
+        if (ec != ParserError::PARSER_SUCCESS)
+        {
+            return ec;
+        }
+        bool read = req.drainBody([this, &ec](std::string_view chunk) {
+            ec = feed(chunk);
+            return ec == ParserError::PARSER_SUCCESS;
+        });
+        if (ec != ParserError::PARSER_SUCCESS)
+        {
+            return ec;
+        }
+        if (!read)
+        {
+            return ParserError::ERROR_UNEXPECTED_END_OF_INPUT;
+        }
+        return finish();
+    }
 
+    // Begins a parse.  The body is then passed to feed() in as many pieces
+    // as it arrives in, followed by a call to finish().
+    [[nodiscard]] ParserError start(std::string_view contentType)
+    {
         const std::string boundaryFormat = "multipart/form-data; boundary=";
         if (!contentType.starts_with(boundaryFormat))
         {
@@ -80,8 +105,25 @@ class MultipartParser
         indexBoundary();
         lookbehind.resize(boundary.size() + 8);
         state = State::START;
+        flags = Boundary::NON_BOUNDARY;
+        index = 0;
+        mime_fields.clear();
+        return ParserError::PARSER_SUCCESS;
+    }
+
+    [[nodiscard]] ParserError finish() const
+    {
+        if (state != State::END)
+        {
+            return ParserError::ERROR_UNEXPECTED_END_OF_INPUT;
+        }
+        return ParserError::PARSER_SUCCESS;
+    }
 
-        const std::string& buffer = req.body();
+    // Parses the next piece of the body.  Headers and part data may be split
+    // anywhere between pieces.
+    [[nodiscard]] ParserError feed(std::string_view buffer)
+    {
         size_t len = buffer.size();
         char cl = 0;
 
@@ -148,8 +190,8 @@ class MultipartParser
                             return ParserError::ERROR_EMPTY_HEADER;
                         }
 
-                        currentHeaderName.append(&buffer[headerFieldMark],
-                                                 i - headerFieldMark);
+                        currentHeaderName.append(buffer.substr(
+                            headerFieldMark, i - headerFieldMark));
                         state = State::HEADER_VALUE_START;
                         break;
                     }
@@ -164,16 +206,17 @@ class MultipartParser
                     {
                         break;
                     }
+                    currentHeaderValue.clear();
                     headerValueMark = i;
                     state = State::HEADER_VALUE;
                     [[fallthrough]];
                 case State::HEADER_VALUE:
                     if (c == cr)
                     {
-                        std::string_view value(&buffer[headerValueMark],
-                                               i - headerValueMark);
+                        currentHeaderValue.append(buffer.substr(
+                            headerValueMark, i - headerValueMark));
                         mime_fields.rbegin()->fields.set(currentHeaderName,
-                                                         value);
+                                                         currentHeaderValue);
                         state = State::HEADER_VALUE_ALMOST_DONE;
                     }
                     break;
@@ -220,13 +263,37 @@ class MultipartParser
             }
         }
 
-        if (state != State::END)
+        // Carry whatever is part way through over to the next piece.  A
+        // boundary match in progress is already held in lookbehind.
+        switch (state)
         {
-            return ParserError::ERROR_UNEXPECTED_END_OF_INPUT;
+            case State::HEADER_FIELD:
+                currentHeaderName.append(buffer.substr(headerFieldMark));
+                headerFieldMark = 0;
+                break;
+            case State::HEADER_VALUE:
+                currentHeaderValue.append(buffer.substr(headerValueMark));
+                headerValueMark = 0;
+                break;
+            case State::PART_DATA:
+                if (index == 0)
+                {
+                    addPartData(buffer.substr(partDataMark));
+                }
+                partDataMark = 0;
+                break;
+            default:
+                break;
         }
-
         return ParserError::PARSER_SUCCESS;
     }
+
+    // If set, part data is handed here as it is parsed instead of being
+    // collected in FormPart::content.  The part's headers are complete by
+    // the time its data arrives.  Data for one part may be split over
+    // several calls, and is only valid for the duration of each call.
+    std::function<void(FormPart&, std::string_view)> onPartData;
+
     std::vector<FormPart> mime_fields;
     std::string boundary;
 
@@ -240,6 +307,21 @@ class MultipartParser
         }
     }
 
+    void addPartData(std::string_view data)
+    {
+        if (data.empty())
+        {
+            return;
+        }
+        FormPart& part = mime_fields.back();
+        if (onPartData)
+        {
+            onPartData(part, data);
+            return;
+        }
+        part.content += data;
+    }
+
     static char lower(char c)
     {
         return static_cast<char>(c | 0x20);
@@ -250,8 +332,7 @@ class MultipartParser
         return boundaryIndex[static_cast<unsigned char>(c)];
     }
 
-    void skipNonBoundary(const std::string& buffer, size_t boundaryEnd,
-                         size_t& i)
+    void skipNonBoundary(std::string_view buffer, size_t boundaryEnd, size_t& i)
     {
         // boyer-moore derived algorithm to safely skip non-boundary data
         while (i + boundary.size() <= buffer.length())
@@ -264,7 +345,7 @@ class MultipartParser
         }
     }
 
-    ParserError processPartData(const std::string& buffer, size_t& i, char c)
+    ParserError processPartData(std::string_view buffer, size_t& i, char c)
     {
         size_t prevIndex = index;
 
@@ -274,10 +355,7 @@ class MultipartParser
             {
                 if (index == 0)
                 {
-                    const char* start = &buffer[partDataMark];
-                    size_t size = i - partDataMark;
-                    mime_fields.rbegin()->content +=
-                        std::string_view(start, size);
+                    addPartData(buffer.substr(partDataMark, i - partDataMark));
                 }
                 index++;
             }
@@ -346,7 +424,7 @@ class MultipartParser
             // if our boundary turned out to be rubbish, the captured
             // lookbehind belongs to partData
 
-            mime_fields.rbegin()->content += lookbehind.substr(0, prevIndex);
+            addPartData(std::string_view(lookbehind).substr(0, prevIndex));
             partDataMark = i;
 
             // reconsider the current character even so it interrupted
@@ -0,0 +1,277 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include "dbus_utility.hpp"
+
+#include <sdbusplus/message/native_types.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace dbus
+{
+namespace utility
+{
+
+/**
+ * @brief Local copy of the object mapper's tree and association endpoints.
+ *
+ * Queries follow the same rules as the corresponding ObjectMapper methods.
+ * If the mirror cannot give the same answer as the mapper (the mirror is out
+ * of date, the requested path is unknown, or an association has not been
+ * fetched yet), the query returns std::nullopt and the caller is expected to
+ * ask the mapper instead.  Keeping the mirror up to date is the job of
+ * object_mapper_monitor.hpp.
+ */
+class ObjectMapperMirror
+{
+  public:
+    static ObjectMapperMirror& getInstance()
+    {
+        static ObjectMapperMirror mirror;
+        return mirror;
+    }
+
+    // True when the tree has been loaded and no updates are outstanding
+    bool isCurrent() const
+    {
+        return loaded && !resyncPending && pendingUpdates == 0;
+    }
+
+    // Marks the whole tree out of date until the next replaceTree().  Returns
+    // a token to pass to replaceTree() from the resulting resync.
+    uint64_t markStale()
+    {
+        resyncPending = true;
+        endpoints.clear();
+        return ++staleCount;
+    }
+
+    void replaceTree(const MapperGetSubTreeResponse& subtree, uint64_t token)
+    {
+        objects.clear();
+        for (const auto& [path, services] : subtree)
+        {
+            objects.emplace(path, services);
+        }
+        endpoints.clear();
+        loaded = true;
+        // Another resync was requested while this one was in flight
+        if (token == staleCount)
+        {
+            resyncPending = false;
+        }
+    }
+
+    // Per object updates.  Callers bracket the mapper call that fetches the
+    // new state of an object with beginUpdate() and endUpdate() so that
+    // queries are not answered from the mirror in the meantime.
+    void beginUpdate()
+    {
+        pendingUpdates++;
+    }
+
+    void endUpdate()
+    {
+        if (pendingUpdates > 0)
+        {
+            pendingUpdates--;
+        }
+    }
+
+    void setObject(const std::string& path, const MapperServiceMap& services)
+    {
+        objects.insert_or_assign(path, services);
+    }
+
+    void removeObject(const std::string& path)
+    {
+        objects.erase(path);
+        endpoints.erase(path);
+    }
+
+    bool hasObject(std::string_view path) const
+    {
+        return objects.contains(path);
+    }
+
+    size_t size() const
+    {
+        return objects.size();
+    }
+
+    const MapperEndPoints* getEndPoints(std::string_view path) const
+    {
+        auto it = endpoints.find(path);
+        if (it == endpoints.end())
+        {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    void setEndPoints(const std::string& path, const MapperEndPoints& value)
+    {
+        endpoints.insert_or_assign(path, value);
+    }
+
+    void eraseEndPoints(std::string_view path)
+    {
+        auto it = endpoints.find(path);
+        if (it != endpoints.end())
+        {
+            endpoints.erase(it);
+        }
+    }
+
+    // Same as ObjectMapper.GetSubTree.  Every service on a matching path that
+    // implements at least one of the requested interfaces is returned, with
+    // its full interface list.
+    std::optional<MapperGetSubTreeResponse> getSubTree(
+        std::string_view path, int32_t depth,
+        std::span<const std::string_view> interfaces) const
+    {
+        if (depth <= 0)
+        {
+            depth = std::numeric_limits<int32_t>::max();
+        }
+        std::string_view stripped = path;
+        if (stripped.ends_with('/'))
+        {
+            stripped.remove_suffix(1);
+        }
+        if (!stripped.empty() && !objects.contains(stripped))
+        {
+            return std::nullopt;
+        }
+        std::string prefix(stripped);
+        prefix += '/';
+
+        MapperGetSubTreeResponse subtree;
+        for (auto it = objects.lower_bound(prefix);
+             it != objects.end() && it->first.starts_with(prefix); ++it)
+        {
+            auto objectDepth =
+                std::count(it->first.begin() + stripped.size(),
+                           it->first.end(), '/');
+            if (objectDepth > depth)
+            {
+                continue;
+            }
+            MapperServiceMap services;
+            for (const auto& [service, serviceInterfaces] : it->second)
+            {
+                if (interfaces.empty() ||
+                    hasAnyInterface(serviceInterfaces, interfaces))
+                {
+                    services.emplace_back(service, serviceInterfaces);
+                }
+            }
+            if (!services.empty())
+            {
+                subtree.emplace_back(it->first, std::move(services));
+            }
+        }
+        return subtree;
+    }
+
+    // Same as ObjectMapper.GetAssociatedSubTree: the subtree, restricted to
+    // the endpoints of associatedPath.
+    std::optional<MapperGetSubTreeResponse> getAssociatedSubTree(
+        const std::string& associatedPath, std::string_view path,
+        int32_t depth, std::span<const std::string_view> interfaces) const
+    {
+        const MapperEndPoints* associated = getEndPoints(associatedPath);
+        if (associated == nullptr)
+        {
+            return std::nullopt;
+        }
+        std::optional<MapperGetSubTreeResponse> subtree =
+            getSubTree(path, depth, interfaces);
+        if (!subtree)
+        {
+            return std::nullopt;
+        }
+        std::unordered_set<std::string_view> endpointSet(associated->begin(),
+                                                         associated->end());
+        std::erase_if(*subtree, [&endpointSet](const auto& object) {
+            return !endpointSet.contains(object.first);
+        });
+        return subtree;
+    }
+
+    // Same as ObjectMapper.GetAssociatedSubTreeById.  Association paths that
+    // were needed but not mirrored yet are appended to missingEndPoints.
+    std::optional<MapperGetSubTreeResponse> getAssociatedSubTreeById(
+        const std::string& id, const std::string& path,
+        std::span<const std::string_view> subtreeInterfaces,
+        std::string_view association,
+        std::span<const std::string_view> endpointInterfaces,
+        std::vector<std::string>& missingEndPoints) const
+    {
+        std::optional<MapperGetSubTreeResponse> subtree =
+            getSubTree(path, 0, subtreeInterfaces);
+        if (!subtree)
+        {
+            return std::nullopt;
+        }
+        MapperGetSubTreeResponse result;
+        for (const auto& [objectPath, services] : *subtree)
+        {
+            if (sdbusplus::message::object_path(objectPath).filename() != id)
+            {
+                continue;
+            }
+            std::string associatedPath = objectPath;
+            associatedPath += '/';
+            associatedPath += association;
+            std::optional<MapperGetSubTreeResponse> associated =
+                getAssociatedSubTree(associatedPath, path, 0,
+                                     endpointInterfaces);
+            if (!associated)
+            {
+                missingEndPoints.emplace_back(std::move(associatedPath));
+                continue;
+            }
+            std::ranges::move(*associated, std::back_inserter(result));
+        }
+        if (!missingEndPoints.empty())
+        {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+  private:
+    static bool hasAnyInterface(const std::vector<std::string>& available,
+                                std::span<const std::string_view> wanted)
+    {
+        return std::ranges::any_of(wanted, [&available](std::string_view i) {
+            return std::ranges::find(available, i) != available.end();
+        });
+    }
+
+    // Ordered by path, as the mapper's own map is
+    std::map<std::string, MapperServiceMap, std::less<>> objects;
+    std::map<std::string, MapperEndPoints, std::less<>> endpoints;
+    bool loaded = false;
+    bool resyncPending = false;
+    size_t pendingUpdates = 0;
+    uint64_t staleCount = 0;
+};
+
+} // namespace utility
+} // namespace dbus
@@ -0,0 +1,235 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "io_context_singleton.hpp"
+#include "logging.hpp"
+#include "object_mapper_mirror.hpp"
+
+#include <boost/asio/steady_timer.hpp>
+#include <boost/system/error_code.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/message/native_types.hpp>
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace bmcweb
+{
+
+// Keeps dbus::utility::ObjectMapperMirror in step with the mapper.
+//
+// Objects that are added or removed are refreshed one at a time by asking the
+// mapper for them with GetObject.  The mapper handles InterfacesAdded and
+// InterfacesRemoved synchronously, and the bus delivers the signal to the
+// mapper before our request, so the answer always includes the change.
+// Services appearing or disappearing, or the mapper finishing introspection
+// of a service, cause a debounced reload of the whole tree.
+
+inline void scheduleObjectMapperResync();
+
+inline void resyncObjectMapperMirror(uint64_t token)
+{
+    crow::connections::systemBus->async_method_call(
+        [token](const boost::system::error_code& ec,
+                const dbus::utility::MapperGetSubTreeResponse& subtree) {
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR("Failed to load object mapper tree: {}",
+                                 ec.message());
+                scheduleObjectMapperResync();
+                return;
+            }
+            dbus::utility::ObjectMapperMirror::getInstance().replaceTree(
+                subtree, token);
+            BMCWEB_LOG_DEBUG("Mirrored {} object mapper paths",
+                             subtree.size());
+        },
+        "xyz.openbmc_project.ObjectMapper",
+        "/xyz/openbmc_project/object_mapper",
+        "xyz.openbmc_project.ObjectMapper", "GetSubTree", "/", 0,
+        std::array<std::string, 0>());
+}
+
+inline void scheduleObjectMapperResync()
+{
+    static boost::asio::steady_timer timer(getIoContext());
+    static bool scheduled = false;
+
+    dbus::utility::ObjectMapperMirror::getInstance().markStale();
+    if (scheduled)
+    {
+        return;
+    }
+    scheduled = true;
+    // Services usually come and go in bursts, so wait for things to settle
+    timer.expires_after(std::chrono::seconds(1));
+    timer.async_wait([](const boost::system::error_code& ec) {
+        scheduled = false;
+        if (ec)
+        {
+            return;
+        }
+        resyncObjectMapperMirror(
+            dbus::utility::ObjectMapperMirror::getInstance().markStale());
+    });
+}
+
+inline void refreshMirroredObject(const std::string& path, bool added)
+{
+    dbus::utility::ObjectMapperMirror& mirror =
+        dbus::utility::ObjectMapperMirror::getInstance();
+    mirror.eraseEndPoints(path);
+    mirror.beginUpdate();
+    crow::connections::systemBus->async_method_call(
+        [path, added](const boost::system::error_code& ec,
+                      const dbus::utility::MapperGetObject& object) {
+            dbus::utility::ObjectMapperMirror& mirror2 =
+                dbus::utility::ObjectMapperMirror::getInstance();
+            mirror2.endUpdate();
+            if (ec)
+            {
+                if (ec.value() != EBADR)
+                {
+                    scheduleObjectMapperResync();
+                    return;
+                }
+                mirror2.removeObject(path);
+                // The mapper drops parent paths that only existed to hold
+                // this object, so check the parent as well
+                std::string parent =
+                    sdbusplus::message::object_path(path).parent_path().str;
+                if (!added && parent != "/" && mirror2.hasObject(parent))
+                {
+                    refreshMirroredObject(parent, false);
+                }
+                return;
+            }
+            mirror2.setObject(path, object);
+        },
+        "xyz.openbmc_project.ObjectMapper",
+        "/xyz/openbmc_project/object_mapper",
+        "xyz.openbmc_project.ObjectMapper", "GetObject", path,
+        std::array<std::string, 0>());
+
+    if (!added)
+    {
+        return;
+    }
+    std::string parent =
+        sdbusplus::message::object_path(path).parent_path().str;
+    if (parent == "/" || mirror.hasObject(parent))
+    {
+        return;
+    }
+    // The mapper adds parent paths for new objects
+    mirror.beginUpdate();
+    crow::connections::systemBus->async_method_call(
+        [](const boost::system::error_code& ec,
+           const dbus::utility::MapperGetAncestorsResponse& ancestors) {
+            dbus::utility::ObjectMapperMirror& mirror2 =
+                dbus::utility::ObjectMapperMirror::getInstance();
+            mirror2.endUpdate();
+            if (ec)
+            {
+                // The object was removed again before we got here
+                if (ec.value() != EBADR)
+                {
+                    scheduleObjectMapperResync();
+                }
+                return;
+            }
+            for (const auto& [ancestor, services] : ancestors)
+            {
+                mirror2.setObject(ancestor, services);
+            }
+        },
+        "xyz.openbmc_project.ObjectMapper",
+        "/xyz/openbmc_project/object_mapper",
+        "xyz.openbmc_project.ObjectMapper", "GetAncestors", path,
+        std::array<std::string, 0>());
+}
+
+inline void onMirroredInterfacesAdded(sdbusplus::message_t& msg)
+{
+    sdbusplus::message::object_path path;
+    msg.read(path);
+    refreshMirroredObject(path.str, true);
+}
+
+inline void onMirroredInterfacesRemoved(sdbusplus::message_t& msg)
+{
+    sdbusplus::message::object_path path;
+    msg.read(path);
+    refreshMirroredObject(path.str, false);
+}
+
+inline void onMirroredNameOwnerChanged(sdbusplus::message_t& msg)
+{
+    std::string name;
+    msg.read(name);
+    // The mapper only tracks well known names
+    if (name.starts_with(':'))
+    {
+        return;
+    }
+    BMCWEB_LOG_DEBUG("{} changed owner, reloading object mapper tree", name);
+    scheduleObjectMapperResync();
+}
+
+inline void onMirroredEndPointsChanged(sdbusplus::message_t& msg)
+{
+    dbus::utility::ObjectMapperMirror::getInstance().eraseEndPoints(
+        msg.get_path());
+}
+
+inline void registerObjectMapperMirror()
+{
+    namespace rules = sdbusplus::bus::match::rules;
+
+    static sdbusplus::bus::match_t interfacesAddedMatch(
+        *crow::connections::systemBus,
+        rules::type::signal() +
+            rules::interface("org.freedesktop.DBus.ObjectManager") +
+            rules::member("InterfacesAdded"),
+        onMirroredInterfacesAdded);
+
+    static sdbusplus::bus::match_t interfacesRemovedMatch(
+        *crow::connections::systemBus,
+        rules::type::signal() +
+            rules::interface("org.freedesktop.DBus.ObjectManager") +
+            rules::member("InterfacesRemoved"),
+        onMirroredInterfacesRemoved);
+
+    static sdbusplus::bus::match_t nameOwnerChangedMatch(
+        *crow::connections::systemBus, rules::nameOwnerChanged(),
+        onMirroredNameOwnerChanged);
+
+    static sdbusplus::bus::match_t introspectionCompleteMatch(
+        *crow::connections::systemBus,
+        rules::type::signal() +
+            rules::sender("xyz.openbmc_project.ObjectMapper") +
+            rules::interface("xyz.openbmc_project.ObjectMapper.Private") +
+            rules::member("IntrospectionComplete"),
+        [](sdbusplus::message_t& /*msg*/) { scheduleObjectMapperResync(); });
+
+    static sdbusplus::bus::match_t endpointsChangedMatch(
+        *crow::connections::systemBus,
+        rules::type::signal() +
+            rules::sender("xyz.openbmc_project.ObjectMapper") +
+            rules::interface("org.freedesktop.DBus.Properties") +
+            rules::member("PropertiesChanged") +
+            rules::argN(0, "xyz.openbmc_project.Association"),
+        onMirroredEndPointsChanged);
+
+    resyncObjectMapperMirror(
+        dbus::utility::ObjectMapperMirror::getInstance().markStale());
+}
+
+} // namespace bmcweb
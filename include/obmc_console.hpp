@@ -340,6 +340,7 @@ inline void requestRoutes(App& app)
     BMCWEB_ROUTE(app, "/console0")
         .privileges({{"OpenBMCHostConsole"}})
         .websocket()
+        .permessageDeflate()
         .onopen(onOpen)
         .onclose(onClose)
         .onmessage(onMessage);
@@ -347,6 +348,7 @@ inline void requestRoutes(App& app)
     BMCWEB_ROUTE(app, "/console/<str>")
         .privileges({{"OpenBMCHostConsole"}})
         .websocket()
+        .permessageDeflate()
         .onopen(onOpen)
         .onclose(onClose)
         .onmessage(onMessage);
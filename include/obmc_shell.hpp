@@ -241,6 +241,7 @@ inline void requestRoutes(App& app)
     BMCWEB_ROUTE(app, "/bmc-console")
         .privileges({{"OemIBMPerformService"}})
         .websocket()
+        .permessageDeflate()
         .onopen(onOpen)
         .onclose(onClose)
         .onmessage(onMessage);
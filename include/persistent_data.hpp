@@ -3,18 +3,24 @@
 #pragma once
 
 #include "event_service_store.hpp"
+#include "io_context_singleton.hpp"
 #include "logging.hpp"
 #include "ossl_random.hpp"
 #include "sessions.hpp"
 // NOLINTNEXTLINE(misc-include-cleaner)
 #include "utility.hpp"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/asio/steady_timer.hpp>
 #include <boost/beast/core/file_base.hpp>
 #include <boost/beast/core/file_posix.hpp>
 #include <boost/beast/http/fields.hpp>
 #include <nlohmann/json.hpp>
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
@@ -22,6 +28,7 @@
 #include <optional>
 #include <string>
 #include <system_error>
+#include <unordered_set>
 #include <utility>
 
 namespace persistent_data
@@ -36,16 +43,34 @@ class ConfigFile
     static constexpr const char* filename = "bmcweb_persistent_data.json";
     static constexpr const char* dumpFilename =
         "bmcweb_current_session_snapshot.json";
-    ConfigFile()
+    // Sessions created and removed since filename was last written, one json
+    // object per line
+    static constexpr const char* journalFilename =
+        "bmcweb_persistent_data.journal";
+    // Once the journal holds this many entries, it's folded into filename
+    static constexpr size_t maxJournalEntries = 256;
+    // Config and subscription changes made within this long of each other
+    // are written together
+    static constexpr std::chrono::seconds writeDelay{1};
+    // Logins and logouts are batched into the journal over this window, to
+    // keep flash writes down.  Anything still pending is written at shutdown.
+    static constexpr std::chrono::minutes journalDelay{5};
+
+    ConfigFile() : writeTimer(getIoContext())
     {
         readData();
+        SessionStore::getInstance().onChange = [this](bool fullWrite) {
+            scheduleWrite(fullWrite);
+        };
     }
 
     ~ConfigFile()
     {
+        SessionStore::getInstance().onChange = nullptr;
         // Make sure we aren't writing stale sessions
         persistent_data::SessionStore::getInstance().applySessionTimeouts();
-        if (persistent_data::SessionStore::getInstance().needsWrite())
+        if (persistent_data::SessionStore::getInstance().needsWrite() ||
+            writePending)
         {
             writeData();
         }
@@ -129,8 +154,7 @@ class ConfigFile
                                              newSession->csrfToken,
                                              newSession->uniqueId,
                                              newSession->sessionToken);
-                            SessionStore::getInstance().authTokens.emplace(
-                                newSession->sessionToken, newSession);
+                            SessionStore::getInstance().addSession(newSession);
                         }
                     }
                     else if (item.first == "timeout")
@@ -200,7 +224,7 @@ class ConfigFile
                 }
             }
         }
-        bool needWrite = false;
+        bool needWrite = readJournal();
 
         if (systemUuid.empty())
         {
@@ -211,11 +235,123 @@ class ConfigFile
         {
             needWrite = true;
         }
-        // write revision changes or system uuid changes immediately
+        // write revision changes or system uuid changes immediately, and fold
+        // any journal into the snapshot
         if (needWrite)
         {
             writeData();
         }
+        else
+        {
+            persistedSessions = getPersistentSessionTokens();
+        }
+    }
+
+    // Replays the session journal over the sessions read from filename.
+    // Returns true if it held any entries.
+    static bool readJournal()
+    {
+        std::ifstream journalFile(journalFilename);
+        if (!journalFile.is_open())
+        {
+            return false;
+        }
+        bool found = false;
+        std::string line;
+        while (std::getline(journalFile, line))
+        {
+            nlohmann::json entry = nlohmann::json::parse(line, nullptr, false);
+            const nlohmann::json::object_t* obj =
+                entry.get_ptr<const nlohmann::json::object_t*>();
+            if (obj == nullptr)
+            {
+                // The last entry may have been cut short by a power loss
+                BMCWEB_LOG_ERROR("Stopping at unreadable journal entry");
+                break;
+            }
+            found = true;
+            for (const auto& item : *obj)
+            {
+                if (item.first == "add")
+                {
+                    const nlohmann::json::object_t* sessionObj =
+                        item.second.get_ptr<const nlohmann::json::object_t*>();
+                    if (sessionObj == nullptr)
+                    {
+                        continue;
+                    }
+                    std::shared_ptr<UserSession> newSession =
+                        UserSession::fromJson(*sessionObj);
+                    if (newSession == nullptr)
+                    {
+                        BMCWEB_LOG_ERROR(
+                            "Problem reading session from journal");
+                        continue;
+                    }
+                    SessionStore::getInstance().addSession(newSession);
+                }
+                else if (item.first == "remove")
+                {
+                    const std::string* token =
+                        item.second.get_ptr<const std::string*>();
+                    if (token == nullptr)
+                    {
+                        continue;
+                    }
+                    auto sessionIt =
+                        SessionStore::getInstance().authTokens.find(*token);
+                    if (sessionIt !=
+                        SessionStore::getInstance().authTokens.end())
+                    {
+                        SessionStore::getInstance().removeSession(
+                            sessionIt->second);
+                    }
+                }
+            }
+        }
+        return found;
+    }
+
+    // Coalesces changes into one write.  Config changes rewrite filename
+    // after writeDelay; when only sessions changed, the logins and logouts
+    // are appended to the journal after journalDelay.
+    void scheduleWrite(bool fullWrite = true)
+    {
+        snapshotNeeded = snapshotNeeded || fullWrite;
+        std::chrono::steady_clock::duration delay = journalDelay;
+        if (snapshotNeeded)
+        {
+            delay = writeDelay;
+        }
+        std::chrono::steady_clock::time_point deadline =
+            std::chrono::steady_clock::now() + delay;
+        if (writePending && writeTimer.expiry() <= deadline)
+        {
+            return;
+        }
+        writePending = true;
+        // Cancels any wait for a later deadline
+        writeTimer.expires_at(deadline);
+        writeTimer.async_wait([this](const boost::system::error_code& ec) {
+            if (ec)
+            {
+                return;
+            }
+            flushPendingWrite();
+        });
+    }
+
+    // Writes whatever scheduleWrite is waiting on now
+    void flushPendingWrite()
+    {
+        writePending = false;
+        writeTimer.cancel();
+        if (snapshotNeeded)
+        {
+            writeData();
+            return;
+        }
+        appendJournal();
     }
 
     void writeCurrentSessionData()
@@ -312,9 +448,13 @@ class ConfigFile
                 return;
             }
         }
+        // Written to a temporary file that replaces filename once it's on
+        // disk, so a power loss leaves either the old file or the new one
+        std::string tmpFilename = std::string(filename) + ".tmp";
         boost::beast::file_posix persistentFile;
         boost::system::error_code ec;
-        persistentFile.open(filename, boost::beast::file_mode::write, ec);
+        persistentFile.open(tmpFilename.c_str(), boost::beast::file_mode::write,
+                            ec);
         if (ec)
         {
             BMCWEB_LOG_CRITICAL("Unable to store persistent data to file {}",
@@ -327,7 +467,7 @@ class ConfigFile
             std::filesystem::perms::owner_read |
             std::filesystem::perms::owner_write |
             std::filesystem::perms::group_read;
-        std::filesystem::permissions(filename, permission, ec);
+        std::filesystem::permissions(tmpFilename, permission, ec);
         if (ec)
         {
             BMCWEB_LOG_CRITICAL("Failed to set filesystem permissions {}",
@@ -365,22 +505,9 @@ class ConfigFile
         sessions = nlohmann::json::array();
         for (const auto& p : SessionStore::getInstance().authTokens)
         {
-            if (p.second->sessionType != persistent_data::SessionType::Basic &&
-                p.second->sessionType !=
-                    persistent_data::SessionType::MutualTLS)
+            if (SessionStore::isPersistent(*p.second))
             {
-                nlohmann::json::object_t session;
-                session["unique_id"] = p.second->uniqueId;
-                session["session_token"] = p.second->sessionToken;
-                session["username"] = p.second->username;
-                session["csrf_token"] = p.second->csrfToken;
-                session["client_ip"] = p.second->clientIp;
-                const std::optional<std::string>& clientId = p.second->clientId;
-                if (clientId)
-                {
-                    session["client_id"] = *clientId;
-                }
-                sessions.emplace_back(std::move(session));
+                sessions.emplace_back(sessionToJson(*p.second));
             }
         }
         nlohmann::json& subscriptions = data["subscriptions"];
@@ -430,6 +557,11 @@ class ConfigFile
             subscription["MetricReportDefinitions"] =
                 subValue.metricReportDefinitions;
             subscription["VerifyCertificate"] = subValue.verifyCertificate;
+            if (subValue.batchWindowMs)
+            {
+                subscription["BatchWindowMilliseconds"] =
+                    *subValue.batchWindowMs;
+            }
 
             subscriptions.emplace_back(std::move(subscription));
         }
@@ -439,9 +571,154 @@ class ConfigFile
         if (ec)
         {
             BMCWEB_LOG_ERROR("Failed to write file {}", ec.message());
+            return;
+        }
+        if (fsync(persistentFile.native_handle()) != 0)
+        {
+            BMCWEB_LOG_ERROR("Failed to sync file {}", tmpFilename);
+            return;
+        }
+        persistentFile.close(ec);
+        std::error_code renameEc;
+        std::filesystem::rename(tmpFilename, filename, renameEc);
+        if (renameEc)
+        {
+            BMCWEB_LOG_ERROR("Failed to replace {}: {}", filename,
+                             renameEc.message());
+            return;
+        }
+        // The rename is only durable once the directory entry is on disk
+        std::string dirName = path.empty() ? "." : path.string();
+        int dirFd = open(dirName.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirFd < 0 || fsync(dirFd) != 0)
+        {
+            BMCWEB_LOG_ERROR("Failed to sync directory {}", dirName);
+        }
+        if (dirFd >= 0)
+        {
+            close(dirFd);
+        }
+
+        // Everything in the journal is in the new file now
+        std::error_code removeEc;
+        std::filesystem::remove(journalFilename, removeEc);
+        journalEntries = 0;
+        snapshotNeeded = false;
+        persistedSessions = getPersistentSessionTokens();
+        SessionStore::getInstance().needWrite = false;
+    }
+
+    static nlohmann::json::object_t sessionToJson(
+        const UserSession& userSession)
+    {
+        nlohmann::json::object_t session;
+        session["unique_id"] = userSession.uniqueId;
+        session["session_token"] = userSession.sessionToken;
+        session["username"] = userSession.username;
+        session["csrf_token"] = userSession.csrfToken;
+        session["client_ip"] = userSession.clientIp;
+        if (userSession.clientId)
+        {
+            session["client_id"] = *userSession.clientId;
+        }
+        return session;
+    }
+
+  private:
+    static std::unordered_set<std::string> getPersistentSessionTokens()
+    {
+        std::unordered_set<std::string> tokens;
+        for (const auto& p : SessionStore::getInstance().authTokens)
+        {
+            if (p.second != nullptr && SessionStore::isPersistent(*p.second))
+            {
+                tokens.emplace(p.first);
+            }
+        }
+        return tokens;
+    }
+
+    // Appends the sessions created and removed since the last write to the
+    // journal, which costs the same however many sessions exist
+    void appendJournal()
+    {
+        std::unordered_set<std::string> current = getPersistentSessionTokens();
+        std::string entries;
+        size_t count = 0;
+        for (const std::string& token : current)
+        {
+            if (persistedSessions.contains(token))
+            {
+                continue;
+            }
+            auto it = SessionStore::getInstance().authTokens.find(token);
+            nlohmann::json::object_t entry;
+            entry["add"] = sessionToJson(*it->second);
+            entries += nlohmann::json(entry).dump(
+                -1, ' ', true, nlohmann::json::error_handler_t::replace);
+            entries += '\n';
+            count++;
+        }
+        for (const std::string& token : persistedSessions)
+        {
+            if (current.contains(token))
+            {
+                continue;
+            }
+            nlohmann::json::object_t entry;
+            entry["remove"] = token;
+            entries += nlohmann::json(entry).dump(
+                -1, ' ', true, nlohmann::json::error_handler_t::replace);
+            entries += '\n';
+            count++;
+        }
+        if (count == 0)
+        {
+            SessionStore::getInstance().needWrite = false;
+            return;
+        }
+        if (journalEntries + count > maxJournalEntries)
+        {
+            writeData();
+            return;
+        }
+
+        boost::beast::file_posix journalFile;
+        boost::system::error_code ec;
+        journalFile.open(journalFilename, boost::beast::file_mode::append, ec);
+        if (!ec)
+        {
+            // set the permission of the file to 640
+            std::filesystem::perms permission =
+                std::filesystem::perms::owner_read |
+                std::filesystem::perms::owner_write |
+                std::filesystem::perms::group_read;
+            std::error_code permEc;
+            std::filesystem::permissions(journalFilename, permission, permEc);
+            // Not synced: losing the last batch to a power loss only costs
+            // the affected users a login
+            journalFile.write(entries.data(), entries.size(), ec);
         }
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR("Failed to append to {}, rewriting {}",
+                             journalFilename, filename);
+            writeData();
+            return;
+        }
+        journalEntries += count;
+        persistedSessions = std::move(current);
+        SessionStore::getInstance().needWrite = false;
     }
 
+    boost::asio::steady_timer writeTimer;
+    bool writePending = false;
+    bool snapshotNeeded = false;
+    size_t journalEntries = 0;
+    // Persistent session tokens as of the last write
+    std::unordered_set<std::string> persistedSessions;
+
+  public:
     std::string systemUuid;
 };
 
@@ -18,9 +18,11 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <queue>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace persistent_data
@@ -305,11 +307,38 @@ class SessionStore
             isGenerateSecretKeyRequired,
             "",
             {}});
-        auto it = authTokens.emplace(sessionToken, session);
+        if (!addSession(session))
+        {
+            return nullptr;
+        }
         // Only need to write to disk if session isn't about to be destroyed.
-        needWrite = sessionType != SessionType::Basic &&
-                    sessionType != SessionType::MutualTLS;
-        return it.first->second;
+        if (isPersistent(*session))
+        {
+            markForWrite(false);
+        }
+        return session;
+    }
+
+    // Adds a session restored from disk, or created elsewhere, to the store
+    // and its indexes.  Returns false if its token is already in use.
+    bool addSession(const std::shared_ptr<UserSession>& session)
+    {
+        auto it = authTokens.emplace(session->sessionToken, session);
+        if (!it.second)
+        {
+            return false;
+        }
+        sessionsByUid.emplace(session->uniqueId, session);
+        sessionsByUsername.emplace(session->username, session);
+        if (session->sessionType == SessionType::Basic)
+        {
+            basicSessions.emplace(
+                basicSessionKey(session->username, session->clientIp),
+                session);
+        }
+        expiryQueue.emplace(session->lastUpdated + timeoutInSeconds,
+                            session->sessionToken);
+        return true;
     }
 
     std::shared_ptr<UserSession> loginSessionByToken(std::string_view token)
@@ -332,23 +361,40 @@ class SessionStore
     std::shared_ptr<UserSession> getSessionByUid(std::string_view uid)
     {
         applySessionTimeouts();
-        // TODO(Ed) this is inefficient
-        auto sessionIt = authTokens.begin();
-        while (sessionIt != authTokens.end())
+        auto sessionIt = sessionsByUid.find(std::string(uid));
+        if (sessionIt == sessionsByUid.end())
         {
-            if (sessionIt->second->uniqueId == uid)
-            {
-                return sessionIt->second;
-            }
-            sessionIt++;
+            return nullptr;
+        }
+        return sessionIt->second;
+    }
+
+    // The Basic auth session already created for this user from this address,
+    // if there is one
+    std::shared_ptr<UserSession> getBasicSession(std::string_view username,
+                                                 std::string_view clientIp)
+    {
+        applySessionTimeouts();
+        auto sessionIt =
+            basicSessions.find(basicSessionKey(username, clientIp));
+        if (sessionIt == basicSessions.end())
+        {
+            return nullptr;
         }
-        return nullptr;
+        return sessionIt->second;
     }
 
     void removeSession(const std::shared_ptr<UserSession>& session)
     {
-        authTokens.erase(session->sessionToken);
-        needWrite = true;
+        auto sessionIt = authTokens.find(session->sessionToken);
+        if (sessionIt != authTokens.end())
+        {
+            eraseSession(sessionIt);
+        }
+        if (isPersistent(*session))
+        {
+            markForWrite(false);
+        }
     }
 
     std::vector<std::string> getAllUniqueIds()
@@ -392,34 +438,47 @@ class SessionStore
 
     void removeSessionsByUsername(std::string_view username)
     {
-        std::erase_if(authTokens, [username](const auto& value) {
-            if (value.second == nullptr)
-            {
-                return false;
-            }
-            return value.second->username == username;
-        });
+        removeSessionsByUsernameExceptSession(username, nullptr);
     }
 
     void removeSessionsByUsernameExceptSession(
         std::string_view username, const std::shared_ptr<UserSession>& session)
     {
-        std::erase_if(authTokens, [username, session](const auto& value) {
-            if (value.second == nullptr)
+        std::vector<std::string> tokens;
+        bool persistentRemoved = false;
+        auto range = sessionsByUsername.equal_range(std::string(username));
+        for (auto it = range.first; it != range.second; it++)
+        {
+            if (it->second == nullptr)
             {
-                return false;
+                continue;
             }
-
-            return value.second->username == username &&
-                   value.second->uniqueId != session->uniqueId;
-        });
+            if (session != nullptr && it->second->uniqueId == session->uniqueId)
+            {
+                continue;
+            }
+            tokens.push_back(it->second->sessionToken);
+            persistentRemoved = persistentRemoved || isPersistent(*it->second);
+        }
+        for (const std::string& token : tokens)
+        {
+            auto sessionIt = authTokens.find(token);
+            if (sessionIt != authTokens.end())
+            {
+                eraseSession(sessionIt);
+            }
+        }
+        if (persistentRemoved)
+        {
+            markForWrite(false);
+        }
     }
 
     void updateAuthMethodsConfig(const AuthConfigMethods& config)
     {
         bool isTLSchanged = (authMethodsConfig.tls != config.tls);
         authMethodsConfig = config;
-        needWrite = true;
+        markForWrite(true);
         if (isTLSchanged)
         {
             // recreate socket connections with new settings
@@ -437,6 +496,15 @@ class SessionStore
     {
         return needWrite;
     }
+
+    // Basic and MutualTLS sessions only last for one request, so they're never
+    // written to disk
+    static bool isPersistent(const UserSession& session)
+    {
+        return session.sessionType != SessionType::Basic &&
+               session.sessionType != SessionType::MutualTLS;
+    }
+
     int64_t getTimeoutInSeconds() const
     {
         return std::chrono::seconds(timeoutInSeconds).count();
@@ -445,7 +513,9 @@ class SessionStore
     void updateSessionTimeout(std::chrono::seconds newTimeoutInSeconds)
     {
         timeoutInSeconds = newTimeoutInSeconds;
-        needWrite = true;
+        // Deadlines already queued were worked out with the old timeout
+        rebuildExpiryQueue();
+        markForWrite(true);
     }
 
     static SessionStore& getInstance()
@@ -454,27 +524,37 @@ class SessionStore
         return sessionStore;
     }
 
+    // Expires the sessions whose deadline has passed.  Sessions sit in a queue
+    // ordered by deadline, so this only looks at sessions that are due; a
+    // session used since it was queued is queued again with its new deadline.
     void applySessionTimeouts()
     {
         auto timeNow = std::chrono::steady_clock::now();
-        if (timeNow - lastTimeoutUpdate > std::chrono::seconds(1))
+        bool removed = false;
+        while (!expiryQueue.empty() && expiryQueue.top().first <= timeNow)
         {
-            lastTimeoutUpdate = timeNow;
-            auto authTokensIt = authTokens.begin();
-            while (authTokensIt != authTokens.end())
-            {
-                if (timeNow - authTokensIt->second->lastUpdated >=
-                    timeoutInSeconds)
-                {
-                    authTokensIt = authTokens.erase(authTokensIt);
+            std::string token = expiryQueue.top().second;
+            expiryQueue.pop();
 
-                    needWrite = true;
-                }
-                else
-                {
-                    authTokensIt++;
-                }
+            auto sessionIt = authTokens.find(token);
+            if (sessionIt == authTokens.end())
+            {
+                // Already removed
+                continue;
+            }
+            std::chrono::steady_clock::time_point deadline =
+                sessionIt->second->lastUpdated + timeoutInSeconds;
+            if (deadline > timeNow)
+            {
+                expiryQueue.emplace(deadline, std::move(token));
+                continue;
             }
+            removed = removed || isPersistent(*sessionIt->second);
+            eraseSession(sessionIt);
+        }
+        if (removed)
+        {
+            markForWrite(false);
         }
     }
 
@@ -484,17 +564,106 @@ class SessionStore
     SessionStore& operator=(const SessionStore&&) = delete;
     ~SessionStore() = default;
 
+    // Keyed by session token.  Sessions are added and removed through the
+    // methods above, so the indexes below stay in step.
     std::unordered_map<std::string, std::shared_ptr<UserSession>,
                        std::hash<std::string>, bmcweb::ConstantTimeCompare>
         authTokens;
 
-    std::chrono::time_point<std::chrono::steady_clock> lastTimeoutUpdate;
     bool needWrite{false};
     std::chrono::seconds timeoutInSeconds;
     AuthConfigMethods authMethodsConfig;
 
+    // Told about every change that needs persisting.  fullWrite is false when
+    // only the set of sessions changed.
+    std::function<void(bool fullWrite)> onChange;
+
   private:
     SessionStore() : timeoutInSeconds(1800) {}
+
+    using ExpiryEntry =
+        std::pair<std::chrono::steady_clock::time_point, std::string>;
+
+    static std::string basicSessionKey(std::string_view username,
+                                       std::string_view clientIp)
+    {
+        std::string key(username);
+        key += '\0';
+        key += clientIp;
+        return key;
+    }
+
+    template <typename Map>
+    static void eraseFromIndex(Map& index, const std::string& key,
+                               const UserSession* session)
+    {
+        auto range = index.equal_range(key);
+        for (auto it = range.first; it != range.second; it++)
+        {
+            if (it->second.get() == session)
+            {
+                index.erase(it);
+                return;
+            }
+        }
+    }
+
+    void eraseSession(decltype(authTokens)::iterator sessionIt)
+    {
+        const UserSession* session = sessionIt->second.get();
+        if (session != nullptr)
+        {
+            eraseFromIndex(sessionsByUid, session->uniqueId, session);
+            eraseFromIndex(sessionsByUsername, session->username, session);
+            if (session->sessionType == SessionType::Basic)
+            {
+                eraseFromIndex(
+                    basicSessions,
+                    basicSessionKey(session->username, session->clientIp),
+                    session);
+            }
+        }
+        authTokens.erase(sessionIt);
+
+        // Queue entries for removed sessions are skipped when they come due.
+        // Rebuild the queue if they start to outnumber the live ones.
+        if (expiryQueue.size() > (2 * authTokens.size()) + 64)
+        {
+            rebuildExpiryQueue();
+        }
+    }
+
+    void rebuildExpiryQueue()
+    {
+        std::vector<ExpiryEntry> entries;
+        entries.reserve(authTokens.size());
+        for (const auto& [token, session] : authTokens)
+        {
+            entries.emplace_back(session->lastUpdated + timeoutInSeconds,
+                                 token);
+        }
+        expiryQueue = decltype(expiryQueue)(std::greater<>(),
+                                            std::move(entries));
+    }
+
+    void markForWrite(bool fullWrite)
+    {
+        needWrite = true;
+        if (onChange)
+        {
+            onChange(fullWrite);
+        }
+    }
+
+    std::unordered_map<std::string, std::shared_ptr<UserSession>> sessionsByUid;
+    std::unordered_multimap<std::string, std::shared_ptr<UserSession>>
+        sessionsByUsername;
+    // Basic auth sessions, keyed by username and client address
+    std::unordered_map<std::string, std::shared_ptr<UserSession>>
+        basicSessions;
+    // Soonest deadline first
+    std::priority_queue<ExpiryEntry, std::vector<ExpiryEntry>, std::greater<>>
+        expiryQueue;
 };
 
 } // namespace persistent_data
@@ -4,9 +4,11 @@
 #pragma once
 
 #include <openssl/crypto.h>
+#include <openssl/ssl.h>
 
 #include <boost/asio/ssl/context.hpp>
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -45,4 +47,39 @@ std::shared_ptr<boost::asio::ssl::context> getSslServerContext();
 std::optional<boost::asio::ssl::context> getSSLClientContext(
     VerifyCertificate verifyCertificate);
 
+struct TlsStatistics
+{
+    uint64_t handshakes = 0;
+    // Handshakes that resumed an earlier session instead of a full key
+    // exchange
+    uint64_t resumedHandshakes = 0;
+};
+
+// Handshakes of connections accepted by the server
+TlsStatistics& getServerTlsStatistics();
+
+// Handshakes of connections made by the HTTP client
+TlsStatistics& getClientTlsStatistics();
+
+// Counts a completed handshake on ssl
+void countHandshake(TlsStatistics& stats, SSL* ssl);
+
+// The last resumable TLS session negotiated with a destination, so that new
+// connections to it can resume the session rather than doing a full
+// handshake
+class ClientSessionCache
+{
+  public:
+    // Offers the cached session, if any, for the next handshake on ssl
+    void apply(SSL* ssl) const;
+
+    // Saves the session negotiated on ssl, if it can be resumed.  TLS 1.3
+    // servers send tickets after the handshake, so this is worth calling
+    // again once a response has been read.
+    void save(SSL* ssl);
+
+  private:
+    std::shared_ptr<SSL_SESSION> session;
+};
+
 } // namespace ensuressl
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace crow
+{
+
+/**
+ * @brief Caches the result of User.Manager GetUserInfo per username.
+ *
+ * Every authenticated request needs the role, groups and password expiration
+ * state of the user before the handler can run.  Those values change rarely,
+ * so they are kept here for a short time, and dropped as soon as
+ * user_monitor.hpp observes a change under /xyz/openbmc_project/user.
+ */
+class UserInfoCache
+{
+  public:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::seconds defaultTimeToLive{10};
+    static constexpr std::size_t maxEntries = 64;
+
+    explicit UserInfoCache(clock::duration timeToLiveIn = defaultTimeToLive) :
+        timeToLive(timeToLiveIn)
+    {}
+
+    static UserInfoCache& getInstance()
+    {
+        static UserInfoCache cache;
+        return cache;
+    }
+
+    // Returns the cached user info, or nullptr if none is cached or the entry
+    // has outlived its time to live.
+    const dbus::utility::DBusPropertiesMap* find(const std::string& username)
+    {
+        auto it = entries.find(username);
+        if (it == entries.end())
+        {
+            misses++;
+            return nullptr;
+        }
+        if (clock::now() >= it->second.expires)
+        {
+            entries.erase(it);
+            misses++;
+            return nullptr;
+        }
+        hits++;
+        return &it->second.userInfoMap;
+    }
+
+    // The generation is bumped on every invalidation.  Callers capture it
+    // before starting a D-Bus call, and pass it back to insert(), so that a
+    // reply which raced with an invalidation is never cached.
+    uint64_t getGeneration() const
+    {
+        return generation;
+    }
+
+    void insert(const std::string& username,
+                const dbus::utility::DBusPropertiesMap& userInfoMap,
+                uint64_t requestGeneration)
+    {
+        if (requestGeneration != generation)
+        {
+            BMCWEB_LOG_DEBUG("Not caching stale user info for {}", username);
+            return;
+        }
+        if (entries.size() >= maxEntries && !entries.contains(username))
+        {
+            removeExpired();
+            if (entries.size() >= maxEntries)
+            {
+                entries.clear();
+            }
+        }
+        entries.insert_or_assign(
+            username, Entry{userInfoMap, clock::now() + timeToLive});
+    }
+
+    void invalidate(const std::string& username)
+    {
+        generation++;
+        entries.erase(username);
+    }
+
+    void clear()
+    {
+        generation++;
+        entries.clear();
+    }
+
+    uint64_t getHits() const
+    {
+        return hits;
+    }
+
+    uint64_t getMisses() const
+    {
+        return misses;
+    }
+
+    double getHitRatio() const
+    {
+        uint64_t total = hits + misses;
+        if (total == 0)
+        {
+            return 0.0;
+        }
+        return static_cast<double>(hits) / static_cast<double>(total);
+    }
+
+  private:
+    struct Entry
+    {
+        dbus::utility::DBusPropertiesMap userInfoMap;
+        clock::time_point expires;
+    };
+
+    void removeExpired()
+    {
+        clock::time_point now = clock::now();
+        std::erase_if(entries, [now](const auto& entry) {
+            return now >= entry.second.expires;
+        });
+    }
+
+    clock::duration timeToLive;
+    std::unordered_map<std::string, Entry> entries;
+    uint64_t generation = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+};
+
+} // namespace crow
@@ -1,8 +1,11 @@
 // SPDX-License-Identifier: Apache-2.0
 // SPDX-FileCopyrightText: Copyright OpenBMC Authors
 #pragma once
+#include "basic_auth_cache.hpp"
 #include "dbus_singleton.hpp"
+#include "logging.hpp"
 #include "sessions.hpp"
+#include "user_info_cache.hpp"
 
 #include <sdbusplus/bus/match.hpp>
 #include <sdbusplus/message.hpp>
@@ -18,10 +21,38 @@ inline void onUserRemoved(sdbusplus::message_t& msg)
     sdbusplus::message::object_path p;
     msg.read(p);
     std::string username = p.filename();
+    crow::UserInfoCache::getInstance().invalidate(username);
+    crow::BasicAuthCache::getInstance().invalidate(username);
     persistent_data::SessionStore::getInstance().removeSessionsByUsername(
         username);
 }
 
+inline void onUserAdded(sdbusplus::message_t& msg)
+{
+    sdbusplus::message::object_path p;
+    msg.read(p);
+    crow::UserInfoCache::getInstance().invalidate(p.filename());
+}
+
+inline void onUserPropertiesChanged(sdbusplus::message_t& msg)
+{
+    // Changes to a user object only affect that user.  Anything else under
+    // the user namespace (LDAP role mappings, account policy) can change the
+    // privileges of every user, so drop the whole cache.
+    sdbusplus::message::object_path p(msg.get_path());
+    if (p.parent_path() == "/xyz/openbmc_project/user")
+    {
+        BMCWEB_LOG_DEBUG("User {} changed, invalidating cached user info",
+                         p.filename());
+        crow::UserInfoCache::getInstance().invalidate(p.filename());
+        crow::BasicAuthCache::getInstance().invalidate(p.filename());
+        return;
+    }
+    BMCWEB_LOG_DEBUG("{} changed, invalidating all cached user info", p.str);
+    crow::UserInfoCache::getInstance().clear();
+    crow::BasicAuthCache::getInstance().clear();
+}
+
 inline void registerUserRemovedSignal()
 {
     std::string userRemovedMatchStr =
@@ -30,5 +61,24 @@ inline void registerUserRemovedSignal()
 
     static sdbusplus::bus::match_t userRemovedMatch(
         *crow::connections::systemBus, userRemovedMatchStr, onUserRemoved);
+
+    std::string userAddedMatchStr =
+        sdbusplus::bus::match::rules::interfacesAdded(
+            "/xyz/openbmc_project/user");
+
+    static sdbusplus::bus::match_t userAddedMatch(
+        *crow::connections::systemBus, userAddedMatchStr, onUserAdded);
+
+    std::string userChangedMatchStr =
+        sdbusplus::bus::match::rules::type::signal() +
+        sdbusplus::bus::match::rules::member("PropertiesChanged") +
+        sdbusplus::bus::match::rules::interface(
+            "org.freedesktop.DBus.Properties") +
+        sdbusplus::bus::match::rules::path_namespace(
+            "/xyz/openbmc_project/user");
+
+    static sdbusplus::bus::match_t userChangedMatch(
+        *crow::connections::systemBus, userChangedMatchStr,
+        onUserPropertiesChanged);
 }
 } // namespace bmcweb
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace redfish
+{
+
+namespace event_log
+{
+
+enum class IndexedEntryStatus : uint8_t
+{
+    valid,
+    parseFailed,
+    messageIdNotInRegistry,
+};
+
+struct IndexedLogLine
+{
+    std::string id;
+    std::string line;
+};
+
+// Index of the entries in the rotated redfish event log files, so that
+// pages of the EventLog collection, and single entries, can be read without
+// scanning every file.  Each entry is recorded with its ID and byte offset.
+// The files are only appended to and renamed on rotation, so refresh() only
+// reads data written since the previous refresh, and files are tracked by
+// inode across renames.
+class EventLogIndex
+{
+  public:
+    explicit EventLogIndex(std::filesystem::path logDirIn);
+
+    static EventLogIndex& getInstance();
+
+    // Brings the index up to date with the files on disk
+    void refresh();
+
+    // Number of entries that are listed in the collection
+    size_t getEntryCount() const;
+
+    // True if any entry failed to parse.  The collection can't be produced
+    // in that case.
+    bool hasParseErrors() const;
+
+    // Reads the listed entries [skip, skip + top), oldest first
+    std::vector<IndexedLogLine> readEntries(size_t skip, size_t top) const;
+
+    // Reads the first entry with the given ID
+    std::optional<IndexedLogLine> readEntry(std::string_view id) const;
+
+  private:
+    struct Entry
+    {
+        std::time_t timestamp = 0;
+        uint32_t sequence = 0;
+        IndexedEntryStatus status = IndexedEntryStatus::valid;
+        uint64_t offset = 0;
+    };
+
+    struct File
+    {
+        std::filesystem::path path;
+        dev_t device = 0;
+        ino_t inode = 0;
+        // The start of the file, to notice a new file reusing an inode
+        std::string head;
+        uint64_t indexedSize = 0;
+        // State for generating IDs of entries appended later
+        std::time_t prevTimestamp = 0;
+        uint32_t sequence = 0;
+        std::vector<Entry> entries;
+        // Indexes into entries of the entries listed in the collection
+        std::vector<uint32_t> listed;
+        size_t parseErrors = 0;
+        // The last entry had no trailing newline when it was indexed
+        bool lastUnterminated = false;
+    };
+
+    struct IdLocation
+    {
+        std::time_t timestamp;
+        uint32_t sequence;
+        uint32_t file;
+        uint32_t entry;
+    };
+
+    static bool indexFile(File& file, bool active);
+    static void dropLastEntry(File& file);
+    static std::string makeId(const Entry& entry);
+    static std::optional<std::string> readLine(const File& file,
+                                               const Entry& entry);
+    void rebuildIdIndex() const;
+    void addToIdIndex(const File& file, size_t fileIndex, size_t firstEntry);
+
+    std::filesystem::path logDir;
+    // Oldest first
+    std::vector<File> files;
+    // Sorted by ID, then by position in the log.  Entries appended to the
+    // log are added as they are indexed; it is rebuilt on demand after files
+    // are rotated or replaced.
+    mutable std::vector<IdLocation> idIndex;
+    mutable bool idIndexValid = false;
+};
+
+} // namespace event_log
+
+} // namespace redfish
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+
+// On-disk store of the serialized events sent to subscribers, so that SSE
+// clients reconnecting with Last-Event-ID can be sent what they missed, even
+// across a restart of bmcweb.
+//
+// Events are appended to segment files named after the first event ID they
+// hold.  Each record is the event ID and payload length, followed by the
+// payload.  The newest segment is kept open for appending, and records are
+// written without syncing, so storing an event costs one write() call.  When
+// the segments exceed the size limit the oldest one is deleted.  Reads map the
+// segment into memory and hand out views of the payloads, so replaying never
+// parses or copies the events into the heap.
+class EventReplayLog
+{
+  public:
+    EventReplayLog(std::filesystem::path dirIn, size_t maxBytesIn);
+
+    EventReplayLog(const EventReplayLog&) = delete;
+    EventReplayLog(EventReplayLog&&) = delete;
+    EventReplayLog& operator=(const EventReplayLog&) = delete;
+    EventReplayLog& operator=(EventReplayLog&&) = delete;
+
+    ~EventReplayLog();
+
+    static EventReplayLog& getInstance();
+
+    void append(uint64_t id, std::string_view payload);
+
+    // ID of the newest event, or 0 if there are none
+    uint64_t getLastId() const;
+
+    bool hasEvent(uint64_t id) const;
+
+    // Calls handler with the events that have afterId < id <= endId, in
+    // order, until at least maxBytes of payload have been handed out.
+    // Returns the ID of the last event handed out, or afterId if there were
+    // none.
+    uint64_t read(
+        uint64_t afterId, uint64_t endId, size_t maxBytes,
+        const std::function<void(uint64_t, std::string_view)>& handler) const;
+
+  private:
+    struct Segment
+    {
+        std::filesystem::path path;
+        uint64_t size = 0;
+        // ID and offset of every record in the segment
+        std::vector<std::pair<uint64_t, uint64_t>> records;
+    };
+
+    void load();
+    static bool loadSegment(Segment& segment);
+    void enforceLimit();
+    void closeAppendFd();
+
+    std::filesystem::path dir;
+    size_t maxBytes;
+    // A new segment is started once the current one reaches this size
+    size_t segmentBytes;
+    // Oldest first
+    std::vector<Segment> segments;
+    uint64_t totalBytes = 0;
+    // Open for appending to the newest segment, or -1
+    int appendFd = -1;
+};
+
+} // namespace redfish
@@ -8,6 +8,7 @@
 #include "error_messages.hpp"
 #include "event_logs_object_type.hpp"
 #include "event_matches_filter.hpp"
+#include "event_replay_log.hpp"
 #include "event_service_store.hpp"
 #include "filesystem_log_watcher.hpp"
 #include "io_context_singleton.hpp"
@@ -27,6 +28,7 @@
 #include <boost/url/url_view_base.hpp>
 
 #include <algorithm>
+#include <charconv>
 #include <cstdint>
 #include <cstdlib>
 #include <ctime>
@@ -74,9 +76,43 @@ class EventServiceManager
         nlohmann::json::object_t message;
     };
 
+    // Events kept for SSE clients that reconnect, when the on-disk replay
+    // log is disabled
     constexpr static size_t maxMessages = 200;
     boost::circular_buffer<Event> messages{maxMessages};
 
+    // Keeps an event for SSE clients that reconnect.  The on-disk replay log
+    // stores payload, the message as serialized for the subscribers, which
+    // must be set when the log is enabled.
+    void storeEvent(uint64_t id, const nlohmann::json::object_t& message,
+                    const std::shared_ptr<const std::string>& payload)
+    {
+        if constexpr (BMCWEB_EVENT_REPLAY_LOG_SIZE_KB > 0)
+        {
+            EventReplayLog::getInstance().append(id, *payload);
+        }
+        else
+        {
+            messages.push_back(Event(id, message));
+        }
+    }
+
+    static std::shared_ptr<const std::string> serializeEventRecord(
+        uint64_t id, const nlohmann::json::object_t& record)
+    {
+        nlohmann::json::array_t eventRecord;
+        eventRecord.emplace_back(record);
+
+        nlohmann::json msgJson;
+
+        msgJson["@odata.type"] = "#Event.v1_4_0.Event";
+        msgJson["Name"] = "Event Log";
+        msgJson["Id"] = id;
+        msgJson["Events"] = std::move(eventRecord);
+
+        return serializeEvent(msgJson);
+    }
+
   public:
     EventServiceManager(const EventServiceManager&) = delete;
     EventServiceManager& operator=(const EventServiceManager&) = delete;
@@ -86,6 +122,13 @@ class EventServiceManager
 
     explicit EventServiceManager()
     {
+        if constexpr (BMCWEB_EVENT_REPLAY_LOG_SIZE_KB > 0)
+        {
+            // Carry on from the stored events, so that IDs clients saw before
+            // a restart still refer to the same events
+            eventId =
+                std::max(eventId, EventReplayLog::getInstance().getLastId());
+        }
         // Load config from persist store.
         initConfig();
     }
@@ -253,7 +296,7 @@ class EventServiceManager
         persistent_data::EventServiceStore::getInstance()
             .eventServiceConfig.retryTimeoutInterval = retryTimeoutInterval;
 
-        persistent_data::getConfig().writeData();
+        persistent_data::getConfig().scheduleWrite();
     }
 
     void setEventServiceConfig(const persistent_data::EventServiceConfig& cfg)
@@ -464,7 +507,31 @@ class EventServiceManager
     {
         std::string id = addSubscriptionInternal(subValue);
 
-        if (!lastEventId.empty())
+        if (lastEventId.empty())
+        {
+            return id;
+        }
+        if constexpr (BMCWEB_EVENT_REPLAY_LOG_SIZE_KB > 0)
+        {
+            BMCWEB_LOG_INFO("Attempting to replay events after id {}",
+                            lastEventId);
+            EventReplayLog& log = EventReplayLog::getInstance();
+            uint64_t lastId = 0;
+            const char* end = lastEventId.data() + lastEventId.size();
+            auto [ptr, ec] = std::from_chars(lastEventId.data(), end, lastId);
+            if (ec != std::errc() || ptr != end || !log.hasEvent(lastId))
+            {
+                nlohmann::json msg = messages::eventBufferExceeded();
+
+                std::string strMsg = msg.dump(
+                    2, ' ', true, nlohmann::json::error_handler_t::replace);
+                eventId++;
+                subValue->sendEventToSubscriber(eventId, std::move(strMsg));
+                return id;
+            }
+            subValue->replayEvents(lastId, log.getLastId());
+        }
+        else
         {
             BMCWEB_LOG_INFO("Attempting to find message for last id {}",
                             lastEventId);
@@ -530,6 +597,16 @@ class EventServiceManager
             BMCWEB_LOG_WARNING("Could not find subscription with id {}", id);
             return false;
         }
+        // Events that were already accepted for this destination are still
+        // delivered; the request holds the subscription until it completes
+        size_t pending = obj->second->pendingEventCount();
+        if (pending > 0)
+        {
+            BMCWEB_LOG_INFO("Sending {} batched events of subscription {} "
+                            "before deleting it",
+                            pending, id);
+            obj->second->flushEventBatch();
+        }
         subscriptionsMap.erase(obj);
         auto& event = persistent_data::EventServiceStore::getInstance();
         auto persistentObj = event.subscriptionsConfigMap.find(id);
@@ -644,14 +721,13 @@ class EventServiceManager
         msg["Name"] = "Event Log";
         msg["Events"] = logEntryArray;
 
-        std::string strMsg =
-            msg.dump(2, ' ', true, nlohmann::json::error_handler_t::replace);
+        std::shared_ptr<const std::string> strMsg = serializeEvent(msg);
 
-        messages.push_back(Event(eventId, msg));
+        storeEvent(eventId, msg, strMsg);
         for (const auto& it : subscriptionsMap)
         {
             std::shared_ptr<Subscription> entry = it.second;
-            if (!entry->sendEventToSubscriber(eventId, std::string(strMsg)))
+            if (!entry->sendEventToSubscriber(eventId, strMsg))
             {
                 return false;
             }
@@ -664,10 +740,11 @@ class EventServiceManager
     {
         EventServiceManager& mgr = EventServiceManager::getInstance();
         mgr.eventId++;
+        EventPayloadCache payloads;
         for (const auto& it : mgr.subscriptionsMap)
         {
             Subscription& entry = *it.second;
-            entry.filterAndSendEventLogs(mgr.eventId, eventRecords);
+            entry.filterAndSendEventLogs(mgr.eventId, eventRecords, payloads);
         }
     }
 
@@ -677,10 +754,11 @@ class EventServiceManager
         EventServiceManager& mgr = EventServiceManager::getInstance();
         mgr.eventId++;
 
+        EventPayloadCache payloads;
         for (const auto& it : mgr.subscriptionsMap)
         {
             Subscription& entry = *it.second;
-            entry.filterAndSendReports(mgr.eventId, reportId, var);
+            entry.filterAndSendReports(mgr.eventId, reportId, var, payloads);
         }
     }
 
@@ -701,8 +779,15 @@ class EventServiceManager
         // MemberId is 0 : since we are sending one event record.
         eventMessage["MemberId"] = "0";
 
-        messages.push_back(Event(eventId, eventMessage));
-
+        // The payload is the same for every subscriber, so it's serialized
+        // once and shared.  Unless the replay log needs it, that waits for the
+        // first subscriber that wants it.
+        std::shared_ptr<const std::string> strMsg;
+        if constexpr (BMCWEB_EVENT_REPLAY_LOG_SIZE_KB > 0)
+        {
+            strMsg = serializeEventRecord(eventId, eventMessage);
+        }
+        storeEvent(eventId, eventMessage, strMsg);
         for (auto& it : subscriptionsMap)
         {
             std::shared_ptr<Subscription>& entry = it.second;
@@ -713,19 +798,19 @@ class EventServiceManager
                 continue;
             }
 
-            nlohmann::json::array_t eventRecord;
-            eventRecord.emplace_back(eventMessage);
-
-            nlohmann::json msgJson;
-
-            msgJson["@odata.type"] = "#Event.v1_4_0.Event";
-            msgJson["Name"] = "Event Log";
-            msgJson["Id"] = eventId;
-            msgJson["Events"] = std::move(eventRecord);
+            if (entry->batchesEvents())
+            {
+                nlohmann::json::array_t eventRecord;
+                eventRecord.emplace_back(eventMessage);
+                entry->queueEventRecords(eventId, std::move(eventRecord));
+                continue;
+            }
 
-            std::string strMsg = msgJson.dump(
-                2, ' ', true, nlohmann::json::error_handler_t::replace);
-            entry->sendEventToSubscriber(eventId, std::move(strMsg));
+            if (strMsg == nullptr)
+            {
+                strMsg = serializeEventRecord(eventId, eventMessage);
+            }
+            entry->sendEventToSubscriber(eventId, strMsg);
         }
     }
 };
@@ -38,7 +38,7 @@ inline void afterIfMatchRequest(
     std::string computedEtag = resIn.computeEtag();
     BMCWEB_LOG_DEBUG("User provided if-match etag {} computed etag {}",
                      ifMatchHeader, computedEtag);
-    if (computedEtag != ifMatchHeader)
+    if (!crow::Response::etagMatches(ifMatchHeader, computedEtag))
     {
         messages::preconditionFailed(asyncResp->res);
         return;
@@ -25,12 +25,17 @@ limitations under the License.
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/url/url_view_base.hpp>
+#include <nlohmann/json.hpp>
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace redfish
@@ -52,6 +57,23 @@ struct TestEvent
     std::optional<std::string> severity;
 };
 
+// Serializes an event payload the way every subscriber receives it
+std::shared_ptr<const std::string> serializeEvent(const nlohmann::json& msg);
+
+// Payloads of one event that have already been serialized, keyed by what
+// makes the payload differ between subscribers, so that subscribers that
+// would receive identical bytes share a single buffer.
+struct EventPayloadCache
+{
+    // Keyed by Context and the indexes of the records that passed the filters
+    std::map<std::pair<std::string, std::vector<size_t>>,
+             std::shared_ptr<const std::string>>
+        eventLogs;
+    // Keyed by Context
+    std::map<std::string, std::shared_ptr<const std::string>, std::less<>>
+        reports;
+};
+
 class Subscription : public std::enable_shared_from_this<Subscription>
 {
   public:
@@ -66,7 +88,7 @@ class Subscription : public std::enable_shared_from_this<Subscription>
 
     explicit Subscription(crow::sse_socket::Connection& connIn);
 
-    ~Subscription() = default;
+    ~Subscription();
 
     // callback for subscription sendData
     void resHandler(const std::shared_ptr<Subscription>& /*self*/,
@@ -80,17 +102,46 @@ class Subscription : public std::enable_shared_from_this<Subscription>
 
     bool sendEventToSubscriber(uint64_t eventId, std::string&& msg);
 
+    bool sendEventToSubscriber(uint64_t eventId,
+                               std::shared_ptr<const std::string> msg);
+
+    // True if Event records for this subscription are queued with
+    // queueEventRecords() and delivered in batches, rather than sent one
+    // message per event
+    bool batchesEvents() const;
+
+    // Queues Event records for delivery in the next batch.  eventId is the Id
+    // of the event that produced them.
+    void queueEventRecords(uint64_t eventId, nlohmann::json::array_t records);
+
+    // Sends the queued Event records, if any, as one Event message
+    void flushEventBatch();
+
+    // Number of Event records waiting in the batch
+    size_t pendingEventCount() const;
+
+    // Sends an SSE client the stored events with afterId < id <= endId.
+    // Anything else sent to the subscription in the meantime is held back
+    // until the replay is done.
+    void replayEvents(uint64_t afterId, uint64_t endId);
+
     void filterAndSendEventLogs(
-        uint64_t eventId, const std::vector<EventLogObjectsType>& eventRecords);
+        uint64_t eventId, const std::vector<EventLogObjectsType>& eventRecords,
+        EventPayloadCache& payloads);
 
     void filterAndSendReports(uint64_t eventId, const std::string& reportId,
-                              const telemetry::TimestampReadings& var);
+                              const telemetry::TimestampReadings& var,
+                              EventPayloadCache& payloads);
 
     void updateRetryConfig(uint32_t retryAttempts,
                            uint32_t retryTimeoutInterval);
 
     bool matchSseId(const crow::sse_socket::Connection& thisConn);
 
+    // Queue and connection statistics of a push subscription, or nullopt for
+    // SSE subscriptions
+    std::optional<crow::ConnectionPoolStatistics> getDeliveryStatistics() const;
+
     // Check used to indicate what response codes are valid as part of our retry
     // policy.  2XX is considered acceptable
     static boost::system::error_code retryRespHandler(unsigned int respCode);
@@ -99,6 +150,16 @@ class Subscription : public std::enable_shared_from_this<Subscription>
     std::function<void()> deleter;
 
   private:
+    bool deliverToSubscriber(uint64_t eventId,
+                             std::shared_ptr<const std::string> msg);
+    std::chrono::milliseconds batchWindow() const;
+    // Drops the queued Event records, if any, for a destination that can't
+    // take them
+    void discardEventBatch();
+    void onBatchTimeout(const std::weak_ptr<Subscription>& weakSelf,
+                        const boost::system::error_code& ec);
+    void continueReplay();
+
     boost::urls::url host;
     std::shared_ptr<crow::ConnectionPolicy> policy;
     crow::sse_socket::Connection* sseConn = nullptr;
@@ -106,6 +167,19 @@ class Subscription : public std::enable_shared_from_this<Subscription>
     boost::asio::steady_timer hbTimer;
     std::optional<crow::HttpClient> client;
 
+    // Records waiting for the batch window to close, and the Id of the last
+    // event that produced them
+    nlohmann::json::array_t pendingEvents;
+    uint64_t pendingEventId = 0;
+    boost::asio::steady_timer batchTimer;
+    bool batchTimerArmed = false;
+
+    bool replaying = false;
+    uint64_t replayPosition = 0;
+    uint64_t replayEnd = 0;
+    std::vector<std::pair<uint64_t, std::shared_ptr<const std::string>>>
+        heldEvents;
+
   public:
     std::optional<filter_ast::LogicalAnd> filter;
 };
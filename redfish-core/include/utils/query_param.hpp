@@ -12,12 +12,14 @@
 #include "filter_expr_printer.hpp"
 #include "http_request.hpp"
 #include "http_response.hpp"
+#include "io_context_singleton.hpp"
 #include "json_formatters.hpp"
 #include "logging.hpp"
 #include "str_utility.hpp"
 
 #include <unistd.h>
 
+#include <boost/asio/post.hpp>
 #include <boost/beast/http/status.hpp>
 #include <boost/beast/http/verb.hpp>
 #include <boost/url/params_view.hpp>
@@ -553,34 +555,31 @@ inline bool processOnly(crow::App& app, crow::Response& res,
 
 struct ExpandNode
 {
-    nlohmann::json::json_pointer location;
+    // The navigation reference to be replaced by the expanded resource.  Points
+    // into the response being expanded, which must outlive the node.
+    nlohmann::json* location = nullptr;
     std::string uri;
 
-    bool operator==(const ExpandNode& other) const
-    {
-        return location == other.location && uri == other.uri;
-    }
+    bool operator==(const ExpandNode& other) const = default;
 };
 
 inline void findNavigationReferencesInArrayRecursive(
-    ExpandType eType, nlohmann::json::array_t& array,
-    const nlohmann::json::json_pointer& jsonPtr, int depth, int skipDepth,
+    ExpandType eType, nlohmann::json::array_t& array, int depth, int skipDepth,
     bool inLinks, std::vector<ExpandNode>& out);
 
 inline void findNavigationReferencesInObjectRecursive(
-    ExpandType eType, nlohmann::json::object_t& obj,
-    const nlohmann::json::json_pointer& jsonPtr, int depth, int skipDepth,
-    bool inLinks, std::vector<ExpandNode>& out);
+    ExpandType eType, nlohmann::json& jsonResponse,
+    nlohmann::json::object_t& obj, int depth, int skipDepth, bool inLinks,
+    std::vector<ExpandNode>& out);
 
 // Walks a json object looking for Redfish NavigationReference entries that
 // might need resolved.  It recursively walks the jsonResponse object, looking
-// for links at every level, and returns a list (out) of locations within the
-// tree that need to be expanded.  The current json pointer location p is passed
-// in to reference the current node that's being expanded, so it can be combined
-// with the keys from the jsonResponse object
+// for links at every level, and returns a list (out) of nodes within the tree
+// that need to be expanded.  Object members and array elements don't move
+// while the tree is otherwise left alone, so the nodes are recorded by address
+// and the expanded results are placed without walking the tree again.
 inline void findNavigationReferencesRecursive(
-    ExpandType eType, nlohmann::json& jsonResponse,
-    const nlohmann::json::json_pointer& jsonPtr, int depth, int skipDepth,
+    ExpandType eType, nlohmann::json& jsonResponse, int depth, int skipDepth,
     bool inLinks, std::vector<ExpandNode>& out)
 {
     // If no expand is needed, return early
@@ -593,7 +592,7 @@ inline void findNavigationReferencesRecursive(
         jsonResponse.get_ptr<nlohmann::json::array_t*>();
     if (array != nullptr)
     {
-        findNavigationReferencesInArrayRecursive(eType, *array, jsonPtr, depth,
+        findNavigationReferencesInArrayRecursive(eType, *array, depth,
                                                  skipDepth, inLinks, out);
     }
     nlohmann::json::object_t* obj =
@@ -602,31 +601,26 @@ inline void findNavigationReferencesRecursive(
     {
         return;
     }
-    findNavigationReferencesInObjectRecursive(eType, *obj, jsonPtr, depth,
+    findNavigationReferencesInObjectRecursive(eType, jsonResponse, *obj, depth,
                                               skipDepth, inLinks, out);
 }
 
 inline void findNavigationReferencesInArrayRecursive(
-    ExpandType eType, nlohmann::json::array_t& array,
-    const nlohmann::json::json_pointer& jsonPtr, int depth, int skipDepth,
+    ExpandType eType, nlohmann::json::array_t& array, int depth, int skipDepth,
     bool inLinks, std::vector<ExpandNode>& out)
 {
-    size_t index = 0;
     // For arrays, walk every element in the array
     for (auto& element : array)
     {
-        nlohmann::json::json_pointer newPtr = jsonPtr / index;
-        BMCWEB_LOG_DEBUG("Traversing response at {}", newPtr.to_string());
-        findNavigationReferencesRecursive(eType, element, newPtr, depth,
-                                          skipDepth, inLinks, out);
-        index++;
+        findNavigationReferencesRecursive(eType, element, depth, skipDepth,
+                                          inLinks, out);
     }
 }
 
 inline void findNavigationReferencesInObjectRecursive(
-    ExpandType eType, nlohmann::json::object_t& obj,
-    const nlohmann::json::json_pointer& jsonPtr, int depth, int skipDepth,
-    bool inLinks, std::vector<ExpandNode>& out)
+    ExpandType eType, nlohmann::json& jsonResponse,
+    nlohmann::json::object_t& obj, int depth, int skipDepth, bool inLinks,
+    std::vector<ExpandNode>& out)
 {
     // Navigation References only ever have a single element
     if (obj.size() == 1)
@@ -637,10 +631,10 @@ inline void findNavigationReferencesInObjectRecursive(
                 obj.begin()->second.get_ptr<const std::string*>();
             if (uri != nullptr)
             {
-                BMCWEB_LOG_DEBUG("Found {} at {}", *uri, jsonPtr.to_string());
+                BMCWEB_LOG_DEBUG("Found {}", *uri);
                 if (skipDepth == 0)
                 {
-                    out.push_back({jsonPtr, *uri});
+                    out.push_back({&jsonResponse, *uri});
                 }
                 return;
             }
@@ -693,12 +687,13 @@ inline void findNavigationReferencesInObjectRecursive(
         {
             continue;
         }
-        nlohmann::json::json_pointer newPtr = jsonPtr / element.first;
-        BMCWEB_LOG_DEBUG("Traversing response at {}", newPtr);
-
-        findNavigationReferencesRecursive(eType, element.second, newPtr,
-                                          newDepth, skipDepth, localInLinks,
-                                          out);
+        // Scalars can't hold links
+        if (!element.second.is_structured())
+        {
+            continue;
+        }
+        findNavigationReferencesRecursive(eType, element.second, newDepth,
+                                          skipDepth, localInLinks, out);
     }
 }
 
@@ -712,9 +707,8 @@ inline std::vector<ExpandNode> findNavigationReferences(
     ExpandType eType, int depth, int skipDepth, nlohmann::json& jsonResponse)
 {
     std::vector<ExpandNode> ret;
-    const nlohmann::json::json_pointer root = nlohmann::json::json_pointer("");
     // SkipDepth +1 since we are skipping the root by default.
-    findNavigationReferencesRecursive(eType, jsonResponse, root, depth,
+    findNavigationReferencesRecursive(eType, jsonResponse, depth,
                                       skipDepth + 1, false, ret);
     return ret;
 }
@@ -766,44 +760,57 @@ class MultiAsyncResp : public std::enable_shared_from_this<MultiAsyncResp>
         app(appIn), finalRes(std::move(finalResIn))
     {}
 
-    void addAwaitingResponse(
-        const std::shared_ptr<bmcweb::AsyncResp>& res,
-        const nlohmann::json::json_pointer& finalExpandLocation)
+    void addAwaitingResponse(const std::shared_ptr<bmcweb::AsyncResp>& res,
+                             nlohmann::json& finalExpandLocation)
     {
         res->res.setCompleteRequestHandler(std::bind_front(
-            placeResultStatic, shared_from_this(), finalExpandLocation));
+            placeResultStatic, shared_from_this(), &finalExpandLocation));
     }
 
-    void placeResult(const nlohmann::json::json_pointer& locationToPlace,
-                     crow::Response& res)
+    // locationToPlace points into the final response, which this object keeps
+    // alive until every sub-request has completed
+    void placeResult(nlohmann::json& locationToPlace, crow::Response& res)
     {
-        BMCWEB_LOG_DEBUG("placeResult for {}", locationToPlace);
         propogateError(finalRes->res, res);
         if (!res.jsonValue.is_object() || res.jsonValue.empty())
         {
             return;
         }
-        nlohmann::json& finalObj = finalRes->res.jsonValue[locationToPlace];
-        finalObj = std::move(res.jsonValue);
+        locationToPlace = std::move(res.jsonValue);
     }
 
     // Handles the very first level of Expand, and starts a chain of sub-queries
     // for deeper levels.
     void startQuery(const Query& query, const Query& delegated)
     {
-        std::vector<ExpandNode> nodes = findNavigationReferences(
-            query.expandType, query.expandLevel, delegated.expandLevel,
-            finalRes->res.jsonValue);
+        nodes = findNavigationReferences(query.expandType, query.expandLevel,
+                                         delegated.expandLevel,
+                                         finalRes->res.jsonValue);
         BMCWEB_LOG_DEBUG("{} nodes to traverse", nodes.size());
-        const std::optional<std::string> queryStr = formatQueryForExpand(query);
-        if (!queryStr)
+        std::optional<std::string> queryStrOpt = formatQueryForExpand(query);
+        if (!queryStrOpt)
         {
             messages::internalError(finalRes->res);
             return;
         }
-        for (const ExpandNode& node : nodes)
+        queryStr = std::move(*queryStrOpt);
+        startNextQueries();
+    }
+
+  private:
+    // Sub-requests run at most this many at a time per expanded resource.
+    // Collections with hundreds of members would otherwise queue hundreds of
+    // D-Bus calls at once, and with the D-Bus cache enabled, members that
+    // start together share their GetManagedObjects calls.
+    static constexpr size_t maxQueriesInFlight = 16;
+
+    void startNextQueries()
+    {
+        while (queriesInFlight < maxQueriesInFlight && nextNode < nodes.size())
         {
-            const std::string subQuery = node.uri + *queryStr;
+            const ExpandNode& node = nodes[nextNode];
+            nextNode++;
+            const std::string subQuery = node.uri + queryStr;
             BMCWEB_LOG_DEBUG("URL of subquery:  {}", subQuery);
             std::error_code ec;
             auto newReq = std::make_shared<crow::Request>(
@@ -813,6 +820,7 @@ class MultiAsyncResp : public std::enable_shared_from_this<MultiAsyncResp>
             if (ec)
             {
                 messages::internalError(finalRes->res);
+                nextNode = nodes.size();
                 return;
             }
 
@@ -820,22 +828,30 @@ class MultiAsyncResp : public std::enable_shared_from_this<MultiAsyncResp>
             BMCWEB_LOG_DEBUG("setting completion handler on {}",
                              logPtr(&asyncResp->res));
 
-            addAwaitingResponse(asyncResp, node.location);
+            queriesInFlight++;
+            addAwaitingResponse(asyncResp, *node.location);
             app.handle(newReq, asyncResp);
         }
     }
 
-  private:
-    static void placeResultStatic(
-        const std::shared_ptr<MultiAsyncResp>& multi,
-        const nlohmann::json::json_pointer& locationToPlace,
-        crow::Response& res)
+    static void placeResultStatic(const std::shared_ptr<MultiAsyncResp>& multi,
+                                  nlohmann::json* locationToPlace,
+                                  crow::Response& res)
     {
-        multi->placeResult(locationToPlace, res);
+        multi->placeResult(*locationToPlace, res);
+        multi->queriesInFlight--;
+        // Sub-requests can complete synchronously, so start the next ones
+        // from the io_context instead of recursing
+        boost::asio::post(getIoContext(),
+                          [multi]() { multi->startNextQueries(); });
     }
 
     crow::App& app;
     std::shared_ptr<bmcweb::AsyncResp> finalRes;
+    std::vector<ExpandNode> nodes;
+    std::string queryStr;
+    size_t nextNode = 0;
+    size_t queriesInFlight = 0;
 };
 
 inline void processTopAndSkip(const Query& query, crow::Response& res)
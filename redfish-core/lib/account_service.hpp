@@ -7,6 +7,7 @@
 
 #include "app.hpp"
 #include "async_resp.hpp"
+#include "basic_auth_cache.hpp"
 #include "boost_formatters.hpp"
 #include "certificate_service.hpp"
 #include "dbus_singleton.hpp"
@@ -1351,6 +1352,7 @@ inline void afterVerifyUserExists(
             persistent_data::SessionStore::getInstance()
                 .removeSessionsByUsernameExceptSession(params.username,
                                                        params.session);
+            crow::BasicAuthCache::getInstance().invalidate(params.username);
             messages::success(asyncResp->res);
         }
     }
@@ -11,6 +11,7 @@
 #include "event_service_store.hpp"
 #include "generated/enums/event_destination.hpp"
 #include "http/utility.hpp"
+#include "http_client.hpp"
 #include "http_request.hpp"
 #include "io_context_singleton.hpp"
 #include "logging.hpp"
@@ -334,6 +335,7 @@ inline void requestRoutesEventDestinationCollection(App& app)
             std::optional<std::string> retryPolicy;
             std::optional<bool> sendHeartbeat;
             std::optional<uint64_t> hbIntervalMinutes;
+            std::optional<uint64_t> batchWindowMs;
             std::optional<std::vector<std::string>> msgIds;
             std::optional<std::vector<std::string>> regPrefixes;
             std::optional<std::vector<std::string>> originResources;
@@ -351,6 +353,8 @@ inline void requestRoutesEventDestinationCollection(App& app)
                     "HttpHeaders", headers,                        //
                     "MessageIds", msgIds,                          //
                     "MetricReportDefinitions", mrdJsonArray,       //
+                    "Oem/OpenBMC/BatchWindowMilliseconds",
+                    batchWindowMs,                                 //
                     "OriginResources", originResources,            //
                     "Protocol", protocol,                          //
                     "RegistryPrefixes", regPrefixes,               //
@@ -452,6 +456,13 @@ inline void requestRoutesEventDestinationCollection(App& app)
                         asyncResp->res, "HeartbeatIntervalMinutes", "Protocol");
                     return;
                 }
+                if (batchWindowMs)
+                {
+                    messages::propertyValueConflict(
+                        asyncResp->res, "Oem/OpenBMC/BatchWindowMilliseconds",
+                        "Protocol");
+                    return;
+                }
                 if (msgIds)
                 {
                     messages::propertyValueConflict(asyncResp->res,
@@ -710,6 +721,18 @@ inline void requestRoutesEventDestinationCollection(App& app)
                 }
                 subValue->userSub->hbIntervalMinutes = *hbIntervalMinutes;
             }
+            if (batchWindowMs)
+            {
+                if (*batchWindowMs >
+                    persistent_data::UserSubscription::maxBatchWindowMs)
+                {
+                    messages::propertyValueOutOfRange(
+                        asyncResp->res, *batchWindowMs,
+                        "Oem/OpenBMC/BatchWindowMilliseconds");
+                    return;
+                }
+                subValue->userSub->batchWindowMs = *batchWindowMs;
+            }
 
             if (mrdJsonArray)
             {
@@ -812,6 +835,28 @@ inline void requestRoutesEventDestination(App& app)
                     mrdJsonArray.emplace_back(std::move(mdr));
                 }
                 jVal["MetricReportDefinitions"] = mrdJsonArray;
+
+                std::optional<crow::ConnectionPoolStatistics> stats =
+                    subValue->getDeliveryStatistics();
+                if (stats)
+                {
+                    nlohmann::json& oemOpenBMC = jVal["Oem"]["OpenBMC"];
+                    oemOpenBMC["@odata.type"] =
+                        "#OpenBMCEventDestination.v1_0_0.OpenBMC";
+                    if (userSub.batchWindowMs)
+                    {
+                        oemOpenBMC["BatchWindowMilliseconds"] =
+                            *userSub.batchWindowMs;
+                    }
+                    nlohmann::json& delivery =
+                        oemOpenBMC["DeliveryStatistics"];
+                    delivery["QueuedEvents"] = stats->queueDepth;
+                    delivery["InFlightEvents"] = stats->inFlight;
+                    delivery["DroppedEvents"] = stats->dropped;
+                    delivery["Connections"] = stats->connections;
+                    delivery["InFlightEventLimit"] =
+                        stats->concurrencyLimit;
+                }
             });
     BMCWEB_ROUTE(app, "/redfish/v1/EventService/Subscriptions/<str>/")
         // The below privilege is wrong, it should be ConfigureManager OR
@@ -840,6 +885,7 @@ inline void requestRoutesEventDestination(App& app)
                 std::optional<std::string> retryPolicy;
                 std::optional<bool> sendHeartbeat;
                 std::optional<uint64_t> hbIntervalMinutes;
+                std::optional<uint64_t> batchWindowMs;
                 std::optional<bool> verifyCertificate;
                 std::optional<std::vector<nlohmann::json::object_t>> headers;
 
@@ -849,6 +895,8 @@ inline void requestRoutesEventDestination(App& app)
                         "DeliveryRetryPolicy", retryPolicy,            //
                         "HeartbeatIntervalMinutes", hbIntervalMinutes, //
                         "HttpHeaders", headers,                        //
+                        "Oem/OpenBMC/BatchWindowMilliseconds",
+                        batchWindowMs,                                 //
                         "SendHeartbeat", sendHeartbeat,                //
                         "VerifyCertificate", verifyCertificate         //
                         ))
@@ -856,6 +904,16 @@ inline void requestRoutesEventDestination(App& app)
                     return;
                 }
 
+                if (batchWindowMs &&
+                    *batchWindowMs >
+                        persistent_data::UserSubscription::maxBatchWindowMs)
+                {
+                    messages::propertyValueOutOfRange(
+                        asyncResp->res, *batchWindowMs,
+                        "Oem/OpenBMC/BatchWindowMilliseconds");
+                    return;
+                }
+
                 if (context)
                 {
                     subValue->userSub->customText = *context;
@@ -921,6 +979,14 @@ inline void requestRoutesEventDestination(App& app)
                     subValue->heartbeatParametersChanged();
                 }
 
+                if (batchWindowMs)
+                {
+                    // Events queued under the old window go out now rather
+                    // than waiting for a timer armed with it
+                    subValue->flushEventBatch();
+                    subValue->userSub->batchWindowMs = *batchWindowMs;
+                }
+
                 if (verifyCertificate)
                 {
                     subValue->userSub->verifyCertificate = *verifyCertificate;
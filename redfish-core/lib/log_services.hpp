@@ -10,6 +10,7 @@
 #include "dbus_singleton.hpp"
 #include "dbus_utility.hpp"
 #include "error_messages.hpp"
+#include "event_log_index.hpp"
 #include "generated/enums/log_entry.hpp"
 #include "generated/enums/log_service.hpp"
 #include "http_body.hpp"
@@ -58,16 +59,13 @@
 #include <ctime>
 #include <filesystem>
 #include <format>
-#include <fstream>
 #include <functional>
-#include <iomanip>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <optional>
 #include <ranges>
 #include <span>
-#include <sstream>
 #include <string>
 #include <string_view>
 #include <system_error>
@@ -141,45 +139,6 @@ inline std::string getDumpPath(std::string_view dumpType)
     return dbusDumpPath;
 }
 
-inline bool getUniqueEntryID(const std::string& logEntry, std::string& entryID,
-                             const bool firstEntry = true)
-{
-    static time_t prevTs = 0;
-    static int index = 0;
-    if (firstEntry)
-    {
-        prevTs = 0;
-    }
-
-    // Get the entry timestamp
-    std::time_t curTs = 0;
-    std::tm timeStruct = {};
-    std::istringstream entryStream(logEntry);
-    if (entryStream >> std::get_time(&timeStruct, "%Y-%m-%dT%H:%M:%S"))
-    {
-        curTs = std::mktime(&timeStruct);
-    }
-    // If the timestamp isn't unique, increment the index
-    if (curTs == prevTs)
-    {
-        index++;
-    }
-    else
-    {
-        // Otherwise, reset it
-        index = 0;
-    }
-    // Save the timestamp
-    prevTs = curTs;
-
-    entryID = std::to_string(curTs);
-    if (index > 0)
-    {
-        entryID += "_" + std::to_string(index);
-    }
-    return true;
-}
-
 inline bool getRedfishLogFiles(
     std::vector<std::filesystem::path>& redfishLogFiles)
 {
@@ -1811,57 +1770,26 @@ inline void handleSystemsLogServiceEventLogLogEntryCollection(
 
     nlohmann::json& logEntryArray = asyncResp->res.jsonValue["Members"];
     logEntryArray = nlohmann::json::array();
-    // Go through the log files and create a unique ID for each
-    // entry
-    std::vector<std::filesystem::path> redfishLogFiles;
-    getRedfishLogFiles(redfishLogFiles);
-    uint64_t entryCount = 0;
-    std::string logEntry;
 
-    // Oldest logs are in the last file, so start there and loop
-    // backwards
-    for (auto it = redfishLogFiles.rbegin(); it < redfishLogFiles.rend(); it++)
+    event_log::EventLogIndex& index = event_log::EventLogIndex::getInstance();
+    index.refresh();
+    if (index.hasParseErrors())
     {
-        std::ifstream logStream(*it);
-        if (!logStream.is_open())
-        {
-            continue;
-        }
-
-        // Reset the unique ID on the first entry
-        bool firstEntry = true;
-        while (std::getline(logStream, logEntry))
+        messages::internalError(asyncResp->res);
+        return;
+    }
+    size_t entryCount = index.getEntryCount();
+    for (const event_log::IndexedLogLine& line : index.readEntries(skip, top))
+    {
+        nlohmann::json::object_t bmcLogEntry;
+        LogParseError status =
+            fillEventLogEntryJson(line.id, line.line, bmcLogEntry);
+        if (status != LogParseError::success)
         {
-            std::string idStr;
-            if (!getUniqueEntryID(logEntry, idStr, firstEntry))
-            {
-                continue;
-            }
-            firstEntry = false;
-
-            nlohmann::json::object_t bmcLogEntry;
-            LogParseError status =
-                fillEventLogEntryJson(idStr, logEntry, bmcLogEntry);
-            if (status == LogParseError::messageIdNotInRegistry)
-            {
-                continue;
-            }
-            if (status != LogParseError::success)
-            {
-                messages::internalError(asyncResp->res);
-                return;
-            }
-
-            entryCount++;
-            // Handle paging using skip (number of entries to skip from the
-            // start) and top (number of entries to display)
-            if (entryCount <= skip || entryCount > skip + top)
-            {
-                continue;
-            }
-
-            logEntryArray.emplace_back(std::move(bmcLogEntry));
+            messages::internalError(asyncResp->res);
+            return;
         }
+        logEntryArray.emplace_back(std::move(bmcLogEntry));
     }
     asyncResp->res.jsonValue["Members@odata.count"] = entryCount;
     if (skip + top < entryCount)
@@ -1907,47 +1835,21 @@ inline void handleSystemsLogServiceEventLogEntriesGet(
 
     const std::string& targetID = param;
 
-    // Go through the log files and check the unique ID for each
-    // entry to find the target entry
-    std::vector<std::filesystem::path> redfishLogFiles;
-    getRedfishLogFiles(redfishLogFiles);
-    std::string logEntry;
-
-    // Oldest logs are in the last file, so start there and loop
-    // backwards
-    for (auto it = redfishLogFiles.rbegin(); it < redfishLogFiles.rend(); it++)
+    event_log::EventLogIndex& index = event_log::EventLogIndex::getInstance();
+    index.refresh();
+    std::optional<event_log::IndexedLogLine> line = index.readEntry(targetID);
+    if (line)
     {
-        std::ifstream logStream(*it);
-        if (!logStream.is_open())
-        {
-            continue;
-        }
-
-        // Reset the unique ID on the first entry
-        bool firstEntry = true;
-        while (std::getline(logStream, logEntry))
+        nlohmann::json::object_t bmcLogEntry;
+        LogParseError status =
+            fillEventLogEntryJson(line->id, line->line, bmcLogEntry);
+        if (status != LogParseError::success)
         {
-            std::string idStr;
-            if (!getUniqueEntryID(logEntry, idStr, firstEntry))
-            {
-                continue;
-            }
-            firstEntry = false;
-
-            if (idStr == targetID)
-            {
-                nlohmann::json::object_t bmcLogEntry;
-                LogParseError status =
-                    fillEventLogEntryJson(idStr, logEntry, bmcLogEntry);
-                if (status != LogParseError::success)
-                {
-                    messages::internalError(asyncResp->res);
-                    return;
-                }
-                asyncResp->res.jsonValue.update(bmcLogEntry);
-                return;
-            }
+            messages::internalError(asyncResp->res);
+            return;
         }
+        asyncResp->res.jsonValue.update(bmcLogEntry);
+        return;
     }
     // Requested ID was not found
     messages::resourceNotFound(asyncResp->res, "LogEntry", targetID);
@@ -2,9 +2,15 @@
 // SPDX-FileCopyrightText: Copyright OpenBMC Authors
 #pragma once
 
+#include "bmcweb_config.h"
+
 #include "app.hpp"
 #include "async_resp.hpp"
+#include "etag_hasher.hpp"
+#include "gzip_compressor.hpp"
 #include "http_request.hpp"
+#include "http_response.hpp"
+#include "http_utility.hpp"
 #include "logging.hpp"
 
 #include <tinyxml2.h>
@@ -13,13 +19,18 @@
 #include <boost/beast/http/status.hpp>
 #include <boost/beast/http/verb.hpp>
 
+#include <algorithm>
+#include <array>
 #include <filesystem>
 #include <format>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <utility>
+#include <vector>
 
 namespace redfish
 {
@@ -71,25 +82,19 @@ inline std::string getMetadataPieceForFile(
     return xml;
 }
 
-inline void handleMetadataGet(
-    App& /*app*/, const crow::Request& /*req*/,
-    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+// Builds the $metadata document from the CSDL files in schemaDir.  Files are
+// taken in name order so the document, and its etag, are stable.
+inline std::optional<std::string> buildMetadata(
+    const std::filesystem::path& schemaDir)
 {
-    std::filesystem::path schema("/usr/share/www/redfish/v1/schema");
     std::error_code ec;
-    auto iter = std::filesystem::directory_iterator(schema, ec);
+    auto iter = std::filesystem::directory_iterator(schemaDir, ec);
     if (ec)
     {
-        BMCWEB_LOG_ERROR("Failed to open XML folder {}", schema.string());
-        asyncResp->res.result(
-            boost::beast::http::status::internal_server_error);
-        return;
+        BMCWEB_LOG_ERROR("Failed to open XML folder {}", schemaDir.string());
+        return std::nullopt;
     }
-    std::string xml;
-
-    xml += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-    xml +=
-        "<edmx:Edmx xmlns:edmx=\"http://docs.oasis-open.org/odata/ns/edmx\" Version=\"4.0\">\n";
+    std::vector<std::filesystem::path> files;
     for (const auto& dirEntry : iter)
     {
         std::string path = dirEntry.path().filename();
@@ -97,12 +102,21 @@ inline void handleMetadataGet(
         {
             continue;
         }
-        std::string metadataPiece = getMetadataPieceForFile(dirEntry.path());
+        files.emplace_back(dirEntry.path());
+    }
+    std::ranges::sort(files);
+
+    std::string xml;
+
+    xml += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    xml +=
+        "<edmx:Edmx xmlns:edmx=\"http://docs.oasis-open.org/odata/ns/edmx\" Version=\"4.0\">\n";
+    for (const std::filesystem::path& file : files)
+    {
+        std::string metadataPiece = getMetadataPieceForFile(file);
         if (metadataPiece.empty())
         {
-            asyncResp->res.result(
-                boost::beast::http::status::internal_server_error);
-            return;
+            return std::nullopt;
         }
         xml += metadataPiece;
     }
@@ -114,10 +128,104 @@ inline void handleMetadataGet(
     xml += "        </Schema>\n";
     xml += "    </edmx:DataServices>\n";
     xml += "</edmx:Edmx>\n";
+    return xml;
+}
+
+// A response body that's built once and then shared by every response
+struct CachedDocument
+{
+    std::shared_ptr<const std::string> body;
+    // The same body gzipped, or null when compression is disabled
+    std::shared_ptr<const std::string> gzipBody;
+    std::string etag;
+};
+
+inline CachedDocument makeCachedDocument(std::string&& body)
+{
+    CachedDocument doc;
+    bmcweb::EtagHasher hasher;
+    hasher.update(body);
+    doc.etag = crow::Response::etagFromHash(hasher.finish());
+    if constexpr (BMCWEB_HTTP_COMPRESSION)
+    {
+        std::string gzipped;
+        bmcweb::GzipCompressor compressor;
+        if (compressor.compress(body, true, gzipped))
+        {
+            doc.gzipBody =
+                std::make_shared<const std::string>(std::move(gzipped));
+        }
+    }
+    doc.body = std::make_shared<const std::string>(std::move(body));
+    return doc;
+}
+
+// The schema files only change with the image, so $metadata is built on
+// first use and kept.  A failed build is retried on the next request.
+inline const CachedDocument* getMetadataDocument()
+{
+    static std::optional<CachedDocument> metadata;
+    if (!metadata)
+    {
+        std::optional<std::string> xml =
+            buildMetadata("/usr/share/www/redfish/v1/schema");
+        if (!xml)
+        {
+            return nullptr;
+        }
+        metadata = makeCachedDocument(std::move(*xml));
+    }
+    return &*metadata;
+}
+
+inline void handleMetadataGet(
+    App& /*app*/, const crow::Request& req,
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    const CachedDocument* metadata = getMetadataDocument();
+    if (metadata == nullptr)
+    {
+        asyncResp->res.result(
+            boost::beast::http::status::internal_server_error);
+        return;
+    }
 
+    std::string_view ifNoneMatch =
+        req.getHeaderValue(boost::beast::http::field::if_none_match);
+    if (!ifNoneMatch.empty() &&
+        crow::Response::etagMatches(ifNoneMatch, metadata->etag))
+    {
+        // Echo the validator the client holds, which names the encoding it
+        // has cached
+        asyncResp->res.addHeader(boost::beast::http::field::etag, ifNoneMatch);
+        asyncResp->res.result(boost::beast::http::status::not_modified);
+        return;
+    }
     asyncResp->res.addHeader(boost::beast::http::field::content_type,
                              "application/xml");
-    asyncResp->res.write(std::move(xml));
+
+    if (metadata->gzipBody != nullptr)
+    {
+        asyncResp->res.addHeader(boost::beast::http::field::vary,
+                                 "Accept-Encoding");
+        using http_helpers::Encoding;
+        std::array<Encoding, 2> available{Encoding::GZIP,
+                                          Encoding::UnencodedBytes};
+        if (http_helpers::getPreferredEncoding(
+                req.getHeaderValue(
+                    boost::beast::http::field::accept_encoding),
+                available) == Encoding::GZIP)
+        {
+            asyncResp->res.addHeader(
+                boost::beast::http::field::content_encoding, "gzip");
+            asyncResp->res.addHeader(boost::beast::http::field::etag,
+                                     crow::Response::gzipEtag(metadata->etag));
+            asyncResp->res.response.body().setSharedStr(metadata->gzipBody);
+            return;
+        }
+    }
+    asyncResp->res.addHeader(boost::beast::http::field::etag, metadata->etag);
+    asyncResp->res.response.body().setSharedStr(metadata->body);
 }
 
 inline void requestRoutesMetadata(App& app)
@@ -18,6 +18,7 @@
 #include "query.hpp"
 #include "redfish_util.hpp"
 #include "registries/privilege_registry.hpp"
+#include "ssl_key_handler.hpp"
 #include "utils/dbus_utils.hpp"
 #include "utils/json_utils.hpp"
 #include "utils/stl_utils.hpp"
@@ -217,6 +218,18 @@ inline void getNetworkData(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
 
     asyncResp->res.jsonValue["HostName"] = hostName;
 
+    nlohmann::json& oemOpenBMC = asyncResp->res.jsonValue["Oem"]["OpenBMC"];
+    oemOpenBMC["@odata.type"] =
+        "#OpenBMCManagerNetworkProtocol.v1_0_0.OpenBMC";
+    const ensuressl::TlsStatistics& serverTls =
+        ensuressl::getServerTlsStatistics();
+    const ensuressl::TlsStatistics& clientTls =
+        ensuressl::getClientTlsStatistics();
+    oemOpenBMC["TLS"]["ServerHandshakes"] = serverTls.handshakes;
+    oemOpenBMC["TLS"]["ServerResumedHandshakes"] = serverTls.resumedHandshakes;
+    oemOpenBMC["TLS"]["ClientHandshakes"] = clientTls.handshakes;
+    oemOpenBMC["TLS"]["ClientResumedHandshakes"] = clientTls.resumedHandshakes;
+
     getNTPProtocolEnabled(asyncResp);
 
     getEthernetIfaceData([hostName, asyncResp](
@@ -17,11 +17,13 @@
 #include <boost/beast/http/verb.hpp>
 #include <boost/url/format.hpp>
 
+#include <algorithm>
 #include <array>
 #include <filesystem>
 #include <format>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <string>
 #include <system_error>
@@ -86,6 +88,33 @@ inline void redfish405(App& app, const crow::Request& req,
     }
 }
 
+// The installed schema files only change with the image, so the directory is
+// listed once, on first use, and kept in name order.  Returns null if the
+// directory can't be read; that is retried on the next request.
+inline const std::vector<std::string>* getJsonSchemaFiles()
+{
+    static std::optional<std::vector<std::string>> files;
+    if (files)
+    {
+        return &*files;
+    }
+    std::error_code ec;
+    std::filesystem::directory_iterator dirList(
+        "/usr/share/www/redfish/v1/JsonSchemas", ec);
+    if (ec)
+    {
+        return nullptr;
+    }
+    std::vector<std::string> names;
+    for (const std::filesystem::path& file : dirList)
+    {
+        names.emplace_back(file.filename());
+    }
+    std::ranges::sort(names);
+    files = std::move(names);
+    return &*files;
+}
+
 inline void jsonSchemaIndexGet(
     App& app, const crow::Request& req,
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
@@ -101,17 +130,14 @@ inline void jsonSchemaIndexGet(
     json["Description"] = "Collection of JsonSchemaFiles";
     nlohmann::json::array_t members;
 
-    std::error_code ec;
-    std::filesystem::directory_iterator dirList(
-        "/usr/share/www/redfish/v1/JsonSchemas", ec);
-    if (ec)
+    const std::vector<std::string>* files = getJsonSchemaFiles();
+    if (files == nullptr)
     {
         messages::internalError(asyncResp->res);
         return;
     }
-    for (const std::filesystem::path& file : dirList)
+    for (const std::string& filename : *files)
     {
-        std::string filename = file.filename();
         std::vector<std::string> split;
         bmcweb::split(split, filename, '.');
         if (split.empty())
@@ -137,17 +163,14 @@ inline void jsonSchemaGet(App& app, const crow::Request& req,
         return;
     }
 
-    std::error_code ec;
-    std::filesystem::directory_iterator dirList(
-        "/usr/share/www/redfish/v1/JsonSchemas", ec);
-    if (ec)
+    const std::vector<std::string>* files = getJsonSchemaFiles();
+    if (files == nullptr)
     {
         messages::resourceNotFound(asyncResp->res, "JsonSchemaFile", schema);
         return;
     }
-    for (const std::filesystem::path& file : dirList)
+    for (const std::string& filename : *files)
     {
-        std::string filename = file.filename();
         std::vector<std::string> split;
         bmcweb::split(split, filename, '.');
         if (split.empty())
@@ -93,6 +93,8 @@ struct MemoryFileDescriptor
         fd(memfd_create(filename.c_str(), 0))
     {}
 
+    explicit MemoryFileDescriptor(int fdIn) : fd(fdIn) {}
+
     MemoryFileDescriptor(const MemoryFileDescriptor&) = default;
     MemoryFileDescriptor(MemoryFileDescriptor&& other) noexcept : fd(other.fd)
     {
@@ -725,7 +727,7 @@ inline void handleUpdateServiceSimpleUpdateAction(
     BMCWEB_LOG_DEBUG("Exit UpdateService.SimpleUpdate doPost");
 }
 
-inline void uploadImageFile(crow::Response& res, std::string_view body)
+inline std::ofstream openImageFile()
 {
     std::filesystem::path filepath("/tmp/images/" + bmcweb::getRandomUUID());
 
@@ -736,9 +738,28 @@ inline void uploadImageFile(crow::Response& res, std::string_view body)
     std::filesystem::perms permission =
         std::filesystem::perms::owner_read | std::filesystem::perms::group_read;
     std::filesystem::permissions(filepath, permission);
-    out << body;
+    return out;
+}
+
+inline void uploadImageFile(crow::Response& res, int imageFd)
+{
+    std::ofstream out = openImageFile();
+    bool written = crow::utility::drainFile(
+        imageFd, [&out](std::string_view chunk) {
+            out << chunk;
+            return !out.bad();
+        });
+    if (!written)
+    {
+        messages::internalError(res);
+        cleanUp();
+    }
+}
 
-    if (out.bad())
+inline void uploadImageFile(crow::Response& res, const crow::Request& req)
+{
+    std::ofstream out = openImageFile();
+    if (!req.drainBodyTo(out))
     {
         messages::internalError(res);
         cleanUp();
@@ -789,7 +810,6 @@ inline void setApplyTime(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
 struct MultiPartUpdateParameters
 {
     std::optional<std::string> applyTime;
-    std::string uploadData;
     std::vector<std::string> targets;
 };
 
@@ -820,6 +840,32 @@ inline std::optional<std::string> processUrl(
     return std::make_optional(firmwareId);
 }
 
+// The name given to a form part in its Content-Disposition
+inline std::string getFormPartName(const FormPart& formpart)
+{
+    boost::beast::http::fields::const_iterator it =
+        formpart.fields.find("Content-Disposition");
+    if (it == formpart.fields.end())
+    {
+        return "";
+    }
+    // The construction parameters of param_list must start with `;`
+    size_t index = it->value().find(';');
+    if (index == std::string::npos)
+    {
+        return "";
+    }
+    for (const auto& param :
+         boost::beast::http::param_list{it->value().substr(index)})
+    {
+        if (param.first == "name")
+        {
+            return std::string(param.second);
+        }
+    }
+    return "";
+}
+
 inline std::optional<MultiPartUpdateParameters>
     extractMultipartUpdateParameters(
         const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
@@ -902,19 +948,9 @@ inline std::optional<MultiPartUpdateParameters>
                     return std::nullopt;
                 }
             }
-            else if (param.second == "UpdateFile")
-            {
-                multiRet.uploadData = std::move(formpart.content);
-            }
         }
     }
 
-    if (multiRet.uploadData.empty())
-    {
-        BMCWEB_LOG_ERROR("Upload data is NULL");
-        messages::propertyMissing(asyncResp->res, "UpdateFile");
-        return std::nullopt;
-    }
     if (multiRet.targets.empty())
     {
         messages::propertyMissing(asyncResp->res, "Targets");
@@ -1023,30 +1059,60 @@ inline void handleBMCUpdate(
                 functionalSoftware[0], "xyz.openbmc_project.Software.Manager");
 }
 
-inline void processUpdateRequest(
-    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-    task::Payload&& payload, std::string_view body,
-    const std::string& applyTime, std::vector<std::string>& targets)
+inline std::optional<MemoryFileDescriptor> imageToMemfd(std::string_view body)
 {
     MemoryFileDescriptor memfd("update-image");
     if (memfd.fd == -1)
     {
         BMCWEB_LOG_ERROR("Failed to create image memfd");
-        messages::internalError(asyncResp->res);
-        return;
+        return std::nullopt;
     }
     if (write(memfd.fd, body.data(), body.length()) !=
         static_cast<ssize_t>(body.length()))
     {
         BMCWEB_LOG_ERROR("Failed to write to image memfd");
-        messages::internalError(asyncResp->res);
-        return;
+        return std::nullopt;
+    }
+    if (!memfd.rewind())
+    {
+        return std::nullopt;
+    }
+    return memfd;
+}
+
+// The update route streams its body into a memfd, which can be handed to the
+// updater as is rather than copied
+inline std::optional<MemoryFileDescriptor>
+    requestBodyToMemfd(const crow::Request& req)
+{
+    if (req.bodyFd() == -1)
+    {
+        return imageToMemfd(req.body());
+    }
+    MemoryFileDescriptor memfd(dup(req.bodyFd()));
+    if (memfd.fd == -1)
+    {
+        BMCWEB_LOG_ERROR("Failed to duplicate request body fd");
+        return std::nullopt;
     }
     if (!memfd.rewind())
+    {
+        return std::nullopt;
+    }
+    return memfd;
+}
+
+inline void processUpdateRequest(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    task::Payload&& payload, std::optional<MemoryFileDescriptor>&& image,
+    const std::string& applyTime, std::vector<std::string>& targets)
+{
+    if (!image)
     {
         messages::internalError(asyncResp->res);
         return;
     }
+    MemoryFileDescriptor memfd = std::move(*image);
 
     if (!targets.empty() && targets[0] == BMCWEB_REDFISH_MANAGER_URI_NAME)
     {
@@ -1078,8 +1144,15 @@ inline void processUpdateRequest(
 
 inline void updateMultipartContext(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-    const crow::Request& req, MultipartParser&& parser, const std::string& url)
+    const crow::Request& req, MultipartParser&& parser,
+    std::optional<MemoryFileDescriptor>&& image, const std::string& url)
 {
+    if (!image)
+    {
+        BMCWEB_LOG_ERROR("Upload data is NULL");
+        messages::propertyMissing(asyncResp->res, "UpdateFile");
+        return;
+    }
     std::optional<MultiPartUpdateParameters> multipart =
         extractMultipartUpdateParameters(asyncResp, std::move(parser));
     if (!multipart)
@@ -1101,9 +1174,13 @@ inline void updateMultipartContext(
         }
         task::Payload payload(req);
 
-        processUpdateRequest(asyncResp, std::move(payload),
-                             multipart->uploadData, applyTimeNewVal,
-                             multipart->targets);
+        if (!image->rewind())
+        {
+            messages::internalError(asyncResp->res);
+            return;
+        }
+        processUpdateRequest(asyncResp, std::move(payload), std::move(image),
+                             applyTimeNewVal, multipart->targets);
     }
     else
     {
@@ -1112,7 +1189,7 @@ inline void updateMultipartContext(
         // Setup callback for when new software detected
         monitorForSoftwareAvailable(asyncResp, req, url);
 
-        uploadImageFile(asyncResp->res, multipart->uploadData);
+        uploadImageFile(asyncResp->res, image->fd);
     }
 }
 
@@ -1129,7 +1206,7 @@ inline void doHTTPUpdate(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
         targets.emplace_back(BMCWEB_REDFISH_MANAGER_URI_NAME);
 
         processUpdateRequest(
-            asyncResp, std::move(payload), req.body(),
+            asyncResp, std::move(payload), requestBodyToMemfd(req),
             "xyz.openbmc_project.Software.ApplyTime.RequestedApplyTimes.Immediate",
             targets);
     }
@@ -1139,7 +1216,7 @@ inline void doHTTPUpdate(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
         // Setup callback for when new software detected
         monitorForSoftwareAvailable(asyncResp, req, url);
 
-        uploadImageFile(asyncResp->res, req.body());
+        uploadImageFile(asyncResp->res, req);
         // Not good code, goes against the bmcweb architecture but we have to
         // clear this body for memory reasons. This body can be 200+ MB.. and
         // untaring it can take up another 100MB.
@@ -1170,6 +1247,27 @@ inline void handleUpdateServicePost(
     else if (contentType.starts_with("multipart/form-data"))
     {
         MultipartParser parser;
+        // The image is written out as it's parsed rather than collected in
+        // the parser, so it's only ever held once
+        std::optional<MemoryFileDescriptor> image;
+        bool imageWritten = true;
+        parser.onPartData = [&image, &imageWritten](FormPart& formpart,
+                                                    std::string_view data) {
+            if (getFormPartName(formpart) != "UpdateFile")
+            {
+                formpart.content += data;
+                return;
+            }
+            if (!image)
+            {
+                image.emplace("update-image");
+            }
+            if (write(image->fd, data.data(), data.size()) !=
+                static_cast<ssize_t>(data.size()))
+            {
+                imageWritten = false;
+            }
+        };
 
         ParserError ec = parser.parse(req);
         if (ec != ParserError::PARSER_SUCCESS)
@@ -1180,8 +1278,15 @@ inline void handleUpdateServicePost(
             messages::internalError(asyncResp->res);
             return;
         }
+        if (!imageWritten)
+        {
+            BMCWEB_LOG_ERROR("Failed to write to image memfd");
+            messages::internalError(asyncResp->res);
+            return;
+        }
 
-        updateMultipartContext(asyncResp, req, std::move(parser), url);
+        updateMultipartContext(asyncResp, req, std::move(parser),
+                               std::move(image), url);
         // Not good code, goes against the bmcweb architecture but we have to
         // clear this body for memory reasons. This body can be 200+ MB.. and
         // untaring it can take up another 100MB.
@@ -1206,6 +1311,7 @@ inline void requestRoutesUpdateServiceActionsOemConcurrentUpdate(App& app)
         app,
         "/redfish/v1/UpdateService/Actions/Oem/OemUpdateService.ConcurrentUpdate/")
         .privileges(redfish::privileges::postUpdateService)
+        .streamBodyToFile()
         .methods(boost::beast::http::verb::post)(std::bind_front(
             [&app](App&, const crow::Request& req,
                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
@@ -1551,6 +1657,7 @@ inline void requestRoutesUpdateService(App& app)
 
     BMCWEB_ROUTE(app, "/redfish/v1/UpdateService/update/")
         .privileges(redfish::privileges::postUpdateService)
+        .streamBodyToFile()
         .methods(boost::beast::http::verb::post)(std::bind_front(
             [&app](App&, const crow::Request& req,
                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
@@ -0,0 +1,449 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "event_log_index.hpp"
+
+#include "event_log.hpp"
+#include "logging.hpp"
+#include "registries.hpp"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <ios>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+
+namespace event_log
+{
+
+// Enough of the start of a file to tell two log files apart
+static constexpr size_t headSize = 64;
+
+// Sort key of the ID index.  Position in the log is part of the key, so the
+// first lookup result is the oldest entry with that ID.
+static constexpr auto idKey = [](const auto& loc) {
+    return std::tie(loc.timestamp, loc.sequence, loc.file, loc.entry);
+};
+
+static std::string readHead(const std::filesystem::path& path)
+{
+    std::ifstream stream(path, std::ios::binary);
+    std::string head(headSize, '\0');
+    stream.read(head.data(), static_cast<std::streamsize>(head.size()));
+    head.resize(static_cast<size_t>(stream.gcount()));
+    return head;
+}
+
+static std::time_t parseTimestamp(const std::string& logEntry)
+{
+    std::tm timeStruct = {};
+    std::istringstream entryStream(logEntry);
+    if (entryStream >> std::get_time(&timeStruct, "%Y-%m-%dT%H:%M:%S"))
+    {
+        return std::mktime(&timeStruct);
+    }
+    return 0;
+}
+
+static IndexedEntryStatus classifyEntry(const std::string& logEntry)
+{
+    std::string timestamp;
+    std::string messageID;
+    std::vector<std::string> messageArgs;
+    if (getEventLogParams(logEntry, timestamp, messageID, messageArgs) != 0)
+    {
+        return IndexedEntryStatus::parseFailed;
+    }
+    if (registries::getMessage(messageID) == nullptr)
+    {
+        return IndexedEntryStatus::messageIdNotInRegistry;
+    }
+    return IndexedEntryStatus::valid;
+}
+
+// Parses an ID of the form <timestamp>[_<sequence>]
+static bool parseId(std::string_view id, std::time_t& timestamp,
+                    uint32_t& sequence)
+{
+    sequence = 0;
+    size_t underscore = id.find('_');
+    std::string_view tsStr = id.substr(0, underscore);
+    auto [ptr, ec] =
+        std::from_chars(tsStr.data(), tsStr.data() + tsStr.size(), timestamp);
+    if (ec != std::errc() || ptr != tsStr.data() + tsStr.size())
+    {
+        return false;
+    }
+    if (underscore == std::string_view::npos)
+    {
+        return true;
+    }
+    std::string_view seqStr = id.substr(underscore + 1);
+    auto [ptr2, ec2] = std::from_chars(
+        seqStr.data(), seqStr.data() + seqStr.size(), sequence);
+    return ec2 == std::errc() && ptr2 == seqStr.data() + seqStr.size() &&
+           sequence > 0;
+}
+
+EventLogIndex::EventLogIndex(std::filesystem::path logDirIn) :
+    logDir(std::move(logDirIn))
+{}
+
+EventLogIndex& EventLogIndex::getInstance()
+{
+    static EventLogIndex index("/var/log");
+    return index;
+}
+
+void EventLogIndex::dropLastEntry(File& file)
+{
+    const Entry& last = file.entries.back();
+    if (last.status == IndexedEntryStatus::valid)
+    {
+        file.listed.pop_back();
+    }
+    else if (last.status == IndexedEntryStatus::parseFailed)
+    {
+        file.parseErrors--;
+    }
+    file.indexedSize = last.offset;
+    file.entries.pop_back();
+    file.prevTimestamp = 0;
+    file.sequence = 0;
+    if (!file.entries.empty())
+    {
+        file.prevTimestamp = file.entries.back().timestamp;
+        file.sequence = file.entries.back().sequence;
+    }
+    file.lastUnterminated = false;
+}
+
+// Returns true if entries were added or removed
+bool EventLogIndex::indexFile(File& file, bool active)
+{
+    std::ifstream stream(file.path, std::ios::binary);
+    if (!stream.is_open())
+    {
+        return false;
+    }
+    bool changed = false;
+    if (file.lastUnterminated)
+    {
+        // The file grew after its unterminated last line was indexed, so
+        // that line may have been completed.  Index it again.
+        dropLastEntry(file);
+        changed = true;
+    }
+    stream.seekg(static_cast<std::streamoff>(file.indexedSize));
+
+    std::string logEntry;
+    while (true)
+    {
+        uint64_t offset = file.indexedSize;
+        if (!std::getline(stream, logEntry))
+        {
+            break;
+        }
+        if (stream.eof())
+        {
+            if (active)
+            {
+                // The last line hasn't been completely written yet, pick it
+                // up on the next refresh
+                break;
+            }
+            // Rotated files are no longer written to, so a line without a
+            // trailing newline is as complete as it will get
+            file.indexedSize = offset + logEntry.size();
+            file.lastUnterminated = true;
+        }
+        else
+        {
+            file.indexedSize = static_cast<uint64_t>(stream.tellg());
+        }
+        changed = true;
+
+        // Same ID scheme as the unindexed implementation: the timestamp, with
+        // a sequence number appended for entries sharing a timestamp.
+        std::time_t timestamp = parseTimestamp(logEntry);
+        file.sequence = (timestamp == file.prevTimestamp) ? file.sequence + 1
+                                                          : 0;
+        file.prevTimestamp = timestamp;
+
+        Entry& entry = file.entries.emplace_back();
+        entry.timestamp = timestamp;
+        entry.sequence = file.sequence;
+        entry.offset = offset;
+        entry.status = classifyEntry(logEntry);
+        if (entry.status == IndexedEntryStatus::valid)
+        {
+            file.listed.emplace_back(
+                static_cast<uint32_t>(file.entries.size() - 1));
+        }
+        else if (entry.status == IndexedEntryStatus::parseFailed)
+        {
+            file.parseErrors++;
+        }
+        if (file.lastUnterminated)
+        {
+            break;
+        }
+    }
+    return changed;
+}
+
+void EventLogIndex::refresh()
+{
+    std::vector<std::filesystem::path> paths;
+    std::error_code ec;
+    for (const std::filesystem::directory_entry& dirEnt :
+         std::filesystem::directory_iterator(logDir, ec))
+    {
+        if (dirEnt.path().filename().string().starts_with("redfish"))
+        {
+            paths.emplace_back(dirEnt.path());
+        }
+    }
+    // Rotated files are suffixed with a number that is higher for older
+    // files, so sorting and reversing puts them oldest first.
+    std::ranges::sort(paths);
+    std::ranges::reverse(paths);
+
+    bool filesChanged = paths.size() != files.size();
+    std::vector<File> newFiles;
+    newFiles.reserve(paths.size());
+    for (std::filesystem::path& path : paths)
+    {
+        struct stat st{};
+        if (stat(path.c_str(), &st) != 0)
+        {
+            continue;
+        }
+        std::string head = readHead(path);
+        auto existing = std::ranges::find_if(files, [&](const File& file) {
+            return file.device == st.st_dev && file.inode == st.st_ino;
+        });
+        File& file = newFiles.emplace_back();
+        if (existing != files.end() &&
+            static_cast<uint64_t>(st.st_size) >= existing->indexedSize &&
+            head.starts_with(existing->head))
+        {
+            size_t position = static_cast<size_t>(existing - files.begin());
+            filesChanged = filesChanged || position != newFiles.size() - 1;
+            file = std::move(*existing);
+        }
+        else
+        {
+            filesChanged = true;
+            file.device = st.st_dev;
+            file.inode = st.st_ino;
+        }
+        file.path = std::move(path);
+        file.head = std::move(head);
+
+        // Entries are appended to the newest file, which is the one without
+        // a rotation suffix
+        bool active = file.path.filename() == "redfish";
+        size_t firstNewEntry = file.entries.size();
+        // Indexing drops and reads again an unterminated last line
+        bool dropsEntry = file.lastUnterminated;
+        if (static_cast<uint64_t>(st.st_size) > file.indexedSize &&
+            indexFile(file, active))
+        {
+            if (filesChanged || dropsEntry)
+            {
+                idIndexValid = false;
+            }
+            else if (idIndexValid)
+            {
+                addToIdIndex(file, newFiles.size() - 1, firstNewEntry);
+            }
+        }
+    }
+    files = std::move(newFiles);
+    if (filesChanged)
+    {
+        idIndexValid = false;
+    }
+}
+
+size_t EventLogIndex::getEntryCount() const
+{
+    size_t count = 0;
+    for (const File& file : files)
+    {
+        count += file.listed.size();
+    }
+    return count;
+}
+
+bool EventLogIndex::hasParseErrors() const
+{
+    return std::ranges::any_of(
+        files, [](const File& file) { return file.parseErrors > 0; });
+}
+
+std::string EventLogIndex::makeId(const Entry& entry)
+{
+    std::string id = std::to_string(entry.timestamp);
+    if (entry.sequence > 0)
+    {
+        id += "_" + std::to_string(entry.sequence);
+    }
+    return id;
+}
+
+std::optional<std::string> EventLogIndex::readLine(const File& file,
+                                                   const Entry& entry)
+{
+    std::ifstream stream(file.path, std::ios::binary);
+    if (!stream.is_open())
+    {
+        return std::nullopt;
+    }
+    stream.seekg(static_cast<std::streamoff>(entry.offset));
+    std::string line;
+    if (!std::getline(stream, line))
+    {
+        return std::nullopt;
+    }
+    return line;
+}
+
+std::vector<IndexedLogLine> EventLogIndex::readEntries(size_t skip,
+                                                       size_t top) const
+{
+    std::vector<IndexedLogLine> lines;
+    for (const File& file : files)
+    {
+        if (lines.size() >= top)
+        {
+            break;
+        }
+        if (skip >= file.listed.size())
+        {
+            skip -= file.listed.size();
+            continue;
+        }
+        std::ifstream stream(file.path, std::ios::binary);
+        if (!stream.is_open())
+        {
+            BMCWEB_LOG_ERROR("Failed to open {}", file.path.string());
+            skip = 0;
+            continue;
+        }
+        for (size_t i = skip; i < file.listed.size() && lines.size() < top;
+             i++)
+        {
+            const Entry& entry = file.entries[file.listed[i]];
+            stream.seekg(static_cast<std::streamoff>(entry.offset));
+            IndexedLogLine& line = lines.emplace_back();
+            line.id = makeId(entry);
+            std::getline(stream, line.line);
+        }
+        skip = 0;
+    }
+    return lines;
+}
+
+void EventLogIndex::rebuildIdIndex() const
+{
+    idIndex.clear();
+    for (size_t fileIndex = 0; fileIndex < files.size(); fileIndex++)
+    {
+        const File& file = files[fileIndex];
+        for (size_t entryIndex = 0; entryIndex < file.entries.size();
+             entryIndex++)
+        {
+            const Entry& entry = file.entries[entryIndex];
+            idIndex.emplace_back(entry.timestamp, entry.sequence,
+                                 static_cast<uint32_t>(fileIndex),
+                                 static_cast<uint32_t>(entryIndex));
+        }
+    }
+    std::ranges::sort(idIndex, {}, idKey);
+    idIndexValid = true;
+}
+
+// Entries are indexed in log order, and follow every indexed entry in the
+// log, so each one normally belongs at the end.  An entry with an older
+// timestamp, e.g. after the clock was set back, is inserted in place.
+void EventLogIndex::addToIdIndex(const File& file, size_t fileIndex,
+                                 size_t firstEntry)
+{
+    for (size_t entryIndex = firstEntry; entryIndex < file.entries.size();
+         entryIndex++)
+    {
+        const Entry& entry = file.entries[entryIndex];
+        IdLocation loc{entry.timestamp, entry.sequence,
+                       static_cast<uint32_t>(fileIndex),
+                       static_cast<uint32_t>(entryIndex)};
+        if (idIndex.empty() || idKey(idIndex.back()) < idKey(loc))
+        {
+            idIndex.emplace_back(loc);
+            continue;
+        }
+        idIndex.insert(std::ranges::upper_bound(idIndex, idKey(loc), {}, idKey),
+                       loc);
+    }
+}
+
+std::optional<IndexedLogLine> EventLogIndex::readEntry(
+    std::string_view id) const
+{
+    std::time_t timestamp = 0;
+    uint32_t sequence = 0;
+    if (!parseId(id, timestamp, sequence))
+    {
+        return std::nullopt;
+    }
+    if (!idIndexValid)
+    {
+        rebuildIdIndex();
+    }
+    auto it = std::ranges::lower_bound(
+        idIndex, std::tie(timestamp, sequence), {},
+        [](const IdLocation& loc) {
+            return std::tie(loc.timestamp, loc.sequence);
+        });
+    if (it == idIndex.end() || it->timestamp != timestamp ||
+        it->sequence != sequence)
+    {
+        return std::nullopt;
+    }
+    const File& file = files[it->file];
+    const Entry& entry = file.entries[it->entry];
+    // parseId() also takes non-canonical spellings, such as leading zeros,
+    // which don't name any entry
+    std::string entryId = makeId(entry);
+    if (entryId != id)
+    {
+        return std::nullopt;
+    }
+    std::optional<std::string> line = readLine(file, entry);
+    if (!line)
+    {
+        return std::nullopt;
+    }
+    return IndexedLogLine{std::move(entryId), std::move(*line)};
+}
+
+} // namespace event_log
+
+} // namespace redfish
@@ -0,0 +1,344 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "event_replay_log.hpp"
+
+#include "bmcweb_config.h"
+
+#include "logging.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+
+// Each record starts with the event ID and the payload length
+static constexpr size_t idSize = sizeof(uint64_t);
+static constexpr size_t headerSize = idSize + sizeof(uint32_t);
+
+namespace
+{
+
+// Read only mapping of a whole file
+class MappedFile
+{
+  public:
+    explicit MappedFile(const std::filesystem::path& path)
+    {
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return;
+        }
+        off_t fileSize = lseek(fd, 0, SEEK_END);
+        if (fileSize > 0)
+        {
+            void* addr = mmap(nullptr, static_cast<size_t>(fileSize),
+                              PROT_READ, MAP_SHARED, fd, 0);
+            if (addr != MAP_FAILED)
+            {
+                data = static_cast<const char*>(addr);
+                size = static_cast<size_t>(fileSize);
+            }
+        }
+        close(fd);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    ~MappedFile()
+    {
+        if (data != nullptr)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            munmap(const_cast<char*>(data), size);
+        }
+    }
+
+    std::string_view view() const
+    {
+        if (data == nullptr)
+        {
+            return {};
+        }
+        return {data, size};
+    }
+
+  private:
+    const char* data = nullptr;
+    size_t size = 0;
+};
+
+} // namespace
+
+EventReplayLog::EventReplayLog(std::filesystem::path dirIn,
+                               size_t maxBytesIn) :
+    dir(std::move(dirIn)), maxBytes(maxBytesIn),
+    segmentBytes(std::max<size_t>(maxBytesIn / 4, 4096))
+{
+    if (maxBytes > 0)
+    {
+        load();
+    }
+}
+
+EventReplayLog::~EventReplayLog()
+{
+    closeAppendFd();
+}
+
+EventReplayLog& EventReplayLog::getInstance()
+{
+    static EventReplayLog log(
+        "/var/lib/bmcweb/event_replay",
+        static_cast<size_t>(BMCWEB_EVENT_REPLAY_LOG_SIZE_KB) * 1024U);
+    return log;
+}
+
+bool EventReplayLog::loadSegment(Segment& segment)
+{
+    MappedFile file(segment.path);
+    std::string_view data = file.view();
+    uint64_t offset = 0;
+    while (data.size() - offset >= headerSize)
+    {
+        uint64_t id = 0;
+        uint32_t length = 0;
+        std::memcpy(&id, &data[offset], idSize);
+        std::memcpy(&length, &data[offset + idSize], sizeof(length));
+        if (data.size() - offset - headerSize < length)
+        {
+            break;
+        }
+        if (!segment.records.empty() && id <= segment.records.back().first)
+        {
+            break;
+        }
+        segment.records.emplace_back(id, offset);
+        offset += headerSize + length;
+    }
+    segment.size = offset;
+    if (offset != data.size())
+    {
+        // Most likely a write cut short by a power loss.  Drop the tail so
+        // that appends line up with the records again.
+        BMCWEB_LOG_WARNING("Truncating event replay segment {} to {} bytes",
+                           segment.path.string(), offset);
+        std::error_code ec;
+        std::filesystem::resize_file(segment.path, offset, ec);
+        if (ec)
+        {
+            return false;
+        }
+    }
+    return !segment.records.empty();
+}
+
+void EventReplayLog::load()
+{
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    std::vector<std::filesystem::path> paths;
+    for (const std::filesystem::directory_entry& dirEnt :
+         std::filesystem::directory_iterator(dir, ec))
+    {
+        paths.emplace_back(dirEnt.path());
+    }
+    // Names are zero padded IDs, so they sort in ID order
+    std::ranges::sort(paths);
+
+    for (std::filesystem::path& path : paths)
+    {
+        Segment segment;
+        segment.path = std::move(path);
+        if (!loadSegment(segment) ||
+            (!segments.empty() && segment.records.front().first <=
+                                      segments.back().records.back().first))
+        {
+            std::filesystem::remove(segment.path, ec);
+            continue;
+        }
+        totalBytes += segment.size;
+        segments.emplace_back(std::move(segment));
+    }
+    BMCWEB_LOG_DEBUG("Loaded {} event replay segments, last event {}",
+                     segments.size(), getLastId());
+    enforceLimit();
+}
+
+void EventReplayLog::enforceLimit()
+{
+    while (totalBytes > maxBytes && segments.size() > 1)
+    {
+        std::error_code ec;
+        std::filesystem::remove(segments.front().path, ec);
+        totalBytes -= segments.front().size;
+        segments.erase(segments.begin());
+    }
+}
+
+void EventReplayLog::closeAppendFd()
+{
+    if (appendFd >= 0)
+    {
+        close(appendFd);
+        appendFd = -1;
+    }
+}
+
+void EventReplayLog::append(uint64_t id, std::string_view payload)
+{
+    if (maxBytes == 0)
+    {
+        return;
+    }
+    if (id <= getLastId())
+    {
+        BMCWEB_LOG_ERROR("Event {} is older than the replay log, not storing",
+                         id);
+        return;
+    }
+    uint64_t recordSize = headerSize + payload.size();
+    if (segments.empty() || segments.back().size + recordSize > segmentBytes)
+    {
+        closeAppendFd();
+        Segment& segment = segments.emplace_back();
+        segment.path = dir / std::format("{:020}", id);
+    }
+    Segment& segment = segments.back();
+    if (appendFd < 0)
+    {
+        appendFd = open(segment.path.c_str(),
+                        O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+        if (appendFd < 0)
+        {
+            BMCWEB_LOG_ERROR("Failed to open {}", segment.path.string());
+            if (segment.records.empty())
+            {
+                segments.pop_back();
+            }
+            return;
+        }
+    }
+
+    std::array<char, headerSize> header{};
+    uint32_t length = static_cast<uint32_t>(payload.size());
+    std::memcpy(header.data(), &id, idSize);
+    std::memcpy(&header[idSize], &length, sizeof(length));
+
+    // writev doesn't modify the buffers, but iovec isn't const correct
+    std::array<iovec, 2> iov{
+        iovec{header.data(), header.size()},
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        iovec{const_cast<char*>(payload.data()), payload.size()}};
+    ssize_t written = writev(appendFd, iov.data(), iov.size());
+    if (written != static_cast<ssize_t>(recordSize))
+    {
+        BMCWEB_LOG_ERROR("Failed to write event {} to {}", id,
+                         segment.path.string());
+        // Drop whatever was partially written, so the next record lines up
+        if (ftruncate(appendFd, static_cast<off_t>(segment.size)) != 0)
+        {
+            BMCWEB_LOG_ERROR("Failed to truncate {}", segment.path.string());
+        }
+        if (segment.records.empty())
+        {
+            closeAppendFd();
+            std::error_code ec;
+            std::filesystem::remove(segment.path, ec);
+            segments.pop_back();
+        }
+        return;
+    }
+
+    segment.records.emplace_back(id, segment.size);
+    segment.size += recordSize;
+    totalBytes += recordSize;
+    enforceLimit();
+}
+
+uint64_t EventReplayLog::getLastId() const
+{
+    if (segments.empty() || segments.back().records.empty())
+    {
+        return 0;
+    }
+    return segments.back().records.back().first;
+}
+
+bool EventReplayLog::hasEvent(uint64_t id) const
+{
+    for (const Segment& segment : segments)
+    {
+        if (std::ranges::binary_search(
+                segment.records, id, {},
+                &std::pair<uint64_t, uint64_t>::first))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t EventReplayLog::read(
+    uint64_t afterId, uint64_t endId, size_t maxBytesToRead,
+    const std::function<void(uint64_t, std::string_view)>& handler) const
+{
+    size_t bytesRead = 0;
+    for (const Segment& segment : segments)
+    {
+        if (segment.records.empty() || segment.records.back().first <= afterId)
+        {
+            continue;
+        }
+        MappedFile file(segment.path);
+        std::string_view data = file.view();
+        auto it = std::ranges::upper_bound(
+            segment.records, afterId, {},
+            &std::pair<uint64_t, uint64_t>::first);
+        for (; it != segment.records.end(); it++)
+        {
+            const auto& [id, offset] = *it;
+            if (id > endId || bytesRead >= maxBytesToRead)
+            {
+                return afterId;
+            }
+            if (offset + headerSize > data.size())
+            {
+                BMCWEB_LOG_ERROR("Event replay segment {} is shorter than "
+                                 "expected",
+                                 segment.path.string());
+                return afterId;
+            }
+            uint32_t length = 0;
+            std::memcpy(&length, &data[offset + idSize], sizeof(length));
+            std::string_view payload =
+                data.substr(offset + headerSize, length);
+            handler(id, payload);
+            bytesRead += payload.size();
+            afterId = id;
+        }
+    }
+    return afterId;
+}
+
+} // namespace redfish
@@ -1,6 +1,7 @@
 #include "filesystem_log_watcher.hpp"
 
 #include "event_log.hpp"
+#include "event_log_index.hpp"
 #include "event_logs_object_type.hpp"
 #include "event_service_manager.hpp"
 #include "logging.hpp"
@@ -49,6 +50,9 @@ void FilesystemLogWatcher::cacheRedfishLogFile()
 
 void FilesystemLogWatcher::readEventLogsFromFile()
 {
+    // Index the new entries now, rather than on the next EventLog request
+    event_log::EventLogIndex::getInstance().refresh();
+
     std::ifstream logStream(redfishEventLogFile);
     if (!logStream.good())
     {
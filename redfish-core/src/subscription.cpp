@@ -15,10 +15,13 @@ limitations under the License.
 */
 #include "subscription.hpp"
 
+#include "bmcweb_config.h"
+
 #include "dbus_singleton.hpp"
 #include "event_log.hpp"
 #include "event_logs_object_type.hpp"
 #include "event_matches_filter.hpp"
+#include "event_replay_log.hpp"
 #include "event_service_store.hpp"
 #include "filter_expr_executor.hpp"
 #include "heartbeat_messages.hpp"
@@ -43,12 +46,16 @@ limitations under the License.
 
 #include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <ctime>
 #include <format>
 #include <functional>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
@@ -58,23 +65,44 @@ limitations under the License.
 namespace redfish
 {
 
+std::shared_ptr<const std::string> serializeEvent(const nlohmann::json& msg)
+{
+    return std::make_shared<const std::string>(
+        msg.dump(2, ' ', true, nlohmann::json::error_handler_t::replace));
+}
+
 Subscription::Subscription(
     std::shared_ptr<persistent_data::UserSubscription> userSubIn,
     const boost::urls::url_view_base& url, boost::asio::io_context& ioc) :
     userSub{std::move(userSubIn)},
-    policy(std::make_shared<crow::ConnectionPolicy>()), hbTimer(ioc)
+    policy(std::make_shared<crow::ConnectionPolicy>()), hbTimer(ioc),
+    batchTimer(ioc)
 {
     userSub->destinationUrl = url;
     client.emplace(ioc, policy);
     // Subscription constructor
     policy->invalidResp = retryRespHandler;
+    // Events keep to one connection so that they arrive in order, which
+    // leaves the depth of the pipeline as the ceiling for the number of
+    // events in flight the client adapts to the receiver
+    policy->pipelineDepth = BMCWEB_EVENT_PIPELINE_DEPTH;
 }
 
 Subscription::Subscription(crow::sse_socket::Connection& connIn) :
     userSub{std::make_shared<persistent_data::UserSubscription>()},
-    sseConn(&connIn), hbTimer(crow::connections::systemBus->get_io_context())
+    sseConn(&connIn), hbTimer(crow::connections::systemBus->get_io_context()),
+    batchTimer(crow::connections::systemBus->get_io_context())
 {}
 
+Subscription::~Subscription()
+{
+    if (!pendingEvents.empty())
+    {
+        BMCWEB_LOG_WARNING("Discarding {} batched events of subscription {}",
+                           pendingEvents.size(), userSub->id);
+    }
+}
+
 // callback for subscription sendData
 void Subscription::resHandler(const std::shared_ptr<Subscription>& /*self*/,
                               const crow::Response& res)
@@ -95,6 +123,7 @@ void Subscription::resHandler(const std::shared_ptr<Subscription>& /*self*/,
     if (client->isTerminated())
     {
         hbTimer.cancel();
+        discardEventBatch();
         if (deleter)
         {
             BMCWEB_LOG_INFO("Subscription {} is deleted after MaxRetryAttempts",
@@ -121,13 +150,10 @@ void Subscription::sendHeartbeatEvent()
     msgJson["Name"] = "Heartbeat";
     msgJson["Events"] = std::move(eventRecord);
 
-    std::string strMsg =
-        msgJson.dump(2, ' ', true, nlohmann::json::error_handler_t::replace);
-
     // Note, eventId here is always zero, because this is a a per subscription
     // event and doesn't have an "ID"
     uint64_t eventId = 0;
-    sendEventToSubscriber(eventId, std::move(strMsg));
+    sendEventToSubscriber(eventId, serializeEvent(msgJson));
 }
 
 void Subscription::scheduleNextHeartbeatEvent()
@@ -181,6 +207,118 @@ void Subscription::onHbTimeout(const std::weak_ptr<Subscription>& weakSelf,
 }
 
 bool Subscription::sendEventToSubscriber(uint64_t eventId, std::string&& msg)
+{
+    return sendEventToSubscriber(
+        eventId, std::make_shared<const std::string>(std::move(msg)));
+}
+
+bool Subscription::sendEventToSubscriber(uint64_t eventId,
+                                         std::shared_ptr<const std::string> msg)
+{
+    // Anything still waiting in the batch was generated before this message
+    flushEventBatch();
+    return deliverToSubscriber(eventId, std::move(msg));
+}
+
+bool Subscription::batchesEvents() const
+{
+    // SSE clients hold a connection open already, so there is nothing to save
+    return batchWindow().count() > 0 && client;
+}
+
+std::chrono::milliseconds Subscription::batchWindow() const
+{
+    return std::chrono::milliseconds(
+        userSub->batchWindowMs.value_or(BMCWEB_EVENT_BATCH_WINDOW_MS));
+}
+
+void Subscription::queueEventRecords(uint64_t eventId,
+                                     nlohmann::json::array_t records)
+{
+    std::ranges::move(records, std::back_inserter(pendingEvents));
+    pendingEventId = eventId;
+    if (pendingEvents.size() >=
+        static_cast<size_t>(BMCWEB_EVENT_BATCH_MAX_EVENTS))
+    {
+        flushEventBatch();
+        return;
+    }
+    if (batchTimerArmed)
+    {
+        return;
+    }
+    batchTimerArmed = true;
+    batchTimer.expires_after(batchWindow());
+    batchTimer.async_wait(
+        std::bind_front(&Subscription::onBatchTimeout, this, weak_from_this()));
+}
+
+void Subscription::onBatchTimeout(const std::weak_ptr<Subscription>& weakSelf,
+                                  const boost::system::error_code& ec)
+{
+    if (ec == boost::asio::error::operation_aborted)
+    {
+        return;
+    }
+    std::shared_ptr<Subscription> self = weakSelf.lock();
+    if (!self)
+    {
+        return;
+    }
+    batchTimerArmed = false;
+    if (ec)
+    {
+        BMCWEB_LOG_ERROR("Event batch timer failed: {}", ec);
+    }
+    flushEventBatch();
+}
+
+void Subscription::flushEventBatch()
+{
+    if (batchTimerArmed)
+    {
+        batchTimerArmed = false;
+        batchTimer.cancel();
+    }
+    if (pendingEvents.empty())
+    {
+        return;
+    }
+    BMCWEB_LOG_DEBUG("Sending batch of {} events to subscription {}",
+                     pendingEvents.size(), userSub->id);
+
+    nlohmann::json msg;
+    msg["@odata.type"] = "#Event.v1_4_0.Event";
+    msg["Id"] = std::to_string(pendingEventId);
+    msg["Name"] = "Event Log";
+    msg["Events"] = std::move(pendingEvents);
+    pendingEvents = nlohmann::json::array_t();
+    deliverToSubscriber(pendingEventId, serializeEvent(msg));
+}
+
+size_t Subscription::pendingEventCount() const
+{
+    return pendingEvents.size();
+}
+
+void Subscription::discardEventBatch()
+{
+    if (batchTimerArmed)
+    {
+        batchTimerArmed = false;
+        batchTimer.cancel();
+    }
+    if (pendingEvents.empty())
+    {
+        return;
+    }
+    BMCWEB_LOG_WARNING("Discarding {} batched events of subscription {}",
+                       pendingEvents.size(), userSub->id);
+    pendingEvents = nlohmann::json::array_t();
+}
+
+bool Subscription::deliverToSubscriber(uint64_t eventId,
+                                       std::shared_ptr<const std::string> msg)
 {
     persistent_data::EventServiceConfig eventServiceConfig =
         persistent_data::EventServiceStore::getInstance()
@@ -207,17 +345,72 @@ bool Subscription::sendEventToSubscriber(uint64_t eventId, std::string&& msg)
 
     if (sseConn != nullptr)
     {
-        sseConn->sendSseEvent(std::to_string(eventId), msg);
+        if (replaying)
+        {
+            heldEvents.emplace_back(eventId, std::move(msg));
+            return true;
+        }
+        sseConn->sendSseEvent(std::to_string(eventId), *msg);
     }
     return true;
 }
 
+void Subscription::replayEvents(uint64_t afterId, uint64_t endId)
+{
+    replaying = true;
+    replayPosition = afterId;
+    replayEnd = endId;
+    continueReplay();
+}
+
+void Subscription::continueReplay()
+{
+    if (sseConn == nullptr)
+    {
+        replaying = false;
+        return;
+    }
+    // Enough to keep the socket busy, without queueing the whole log in
+    // the connection's write buffer
+    constexpr size_t replayChunkBytes = 64UL * 1024UL;
+    uint64_t start = replayPosition;
+    replayPosition = EventReplayLog::getInstance().read(
+        replayPosition, replayEnd, replayChunkBytes,
+        [this](uint64_t id, std::string_view payload) {
+            sseConn->sendSseEvent(std::to_string(id), payload);
+        });
+    if (replayPosition != start && replayPosition < replayEnd)
+    {
+        sseConn->onDrain([weakSelf = weak_from_this()]() {
+            std::shared_ptr<Subscription> self = weakSelf.lock();
+            if (self)
+            {
+                self->continueReplay();
+            }
+        });
+        return;
+    }
+
+    BMCWEB_LOG_DEBUG("Replay finished at event {}, sending {} held events",
+                     replayPosition, heldEvents.size());
+    replaying = false;
+    for (auto& [eventId, msg] : heldEvents)
+    {
+        sseConn->sendSseEvent(std::to_string(eventId), *msg);
+    }
+    heldEvents.clear();
+}
+
 void Subscription::filterAndSendEventLogs(
-    uint64_t eventId, const std::vector<EventLogObjectsType>& eventRecords)
+    uint64_t eventId, const std::vector<EventLogObjectsType>& eventRecords,
+    EventPayloadCache& payloads)
 {
+    std::pair<std::string, std::vector<size_t>> key;
+    key.first = userSub->customText;
     nlohmann::json::array_t logEntryArray;
-    for (const EventLogObjectsType& logEntry : eventRecords)
+    for (size_t i = 0; i < eventRecords.size(); i++)
     {
+        const EventLogObjectsType& logEntry = eventRecords[i];
         BMCWEB_LOG_DEBUG("Processing logEntry: {}, {} '{}'", logEntry.id,
                          logEntry.timestamp, logEntry.messageId);
         std::vector<std::string_view> messageArgsView(
@@ -249,6 +442,7 @@ void Subscription::filterAndSendEventLogs(
         }
 
         logEntryArray.emplace_back(std::move(bmcLogEntry));
+        key.second.emplace_back(i);
         eventId++;
     }
 
@@ -258,19 +452,33 @@ void Subscription::filterAndSendEventLogs(
         return;
     }
 
-    nlohmann::json msg;
-    msg["@odata.type"] = "#Event.v1_4_0.Event";
-    msg["Id"] = std::to_string(eventId);
-    msg["Name"] = "Event Log";
-    msg["Events"] = std::move(logEntryArray);
-    std::string strMsg =
-        msg.dump(2, ' ', true, nlohmann::json::error_handler_t::replace);
-    sendEventToSubscriber(eventId, std::move(strMsg));
+    if (batchesEvents())
+    {
+        queueEventRecords(eventId, std::move(logEntryArray));
+        return;
+    }
+
+    // The payload only depends on the Context and on which records were
+    // selected, so another subscriber may have serialized it already
+    auto payload = payloads.eventLogs.find(key);
+    if (payload == payloads.eventLogs.end())
+    {
+        nlohmann::json msg;
+        msg["@odata.type"] = "#Event.v1_4_0.Event";
+        msg["Id"] = std::to_string(eventId);
+        msg["Name"] = "Event Log";
+        msg["Events"] = std::move(logEntryArray);
+        payload =
+            payloads.eventLogs.emplace(std::move(key), serializeEvent(msg))
+                .first;
+    }
+    sendEventToSubscriber(eventId, payload->second);
 }
 
 void Subscription::filterAndSendReports(uint64_t eventId,
                                         const std::string& reportId,
-                                        const telemetry::TimestampReadings& var)
+                                        const telemetry::TimestampReadings& var,
+                                        EventPayloadCache& payloads)
 {
     boost::urls::url mrdUri = boost::urls::format(
         "/redfish/v1/TelemetryService/MetricReportDefinitions/{}", reportId);
@@ -286,25 +494,30 @@ void Subscription::filterAndSendReports(uint64_t eventId,
         }
     }
 
-    nlohmann::json msg;
-    if (!telemetry::fillReport(msg, reportId, var))
+    auto payload = payloads.reports.find(userSub->customText);
+    if (payload == payloads.reports.end())
     {
-        BMCWEB_LOG_ERROR("Failed to fill the MetricReport for DBus "
-                         "Report with id {}",
-                         reportId);
-        return;
-    }
+        nlohmann::json msg;
+        if (!telemetry::fillReport(msg, reportId, var))
+        {
+            BMCWEB_LOG_ERROR("Failed to fill the MetricReport for DBus "
+                             "Report with id {}",
+                             reportId);
+            return;
+        }
 
-    // Context is set by user during Event subscription and it must be
-    // set for MetricReport response.
-    if (!userSub->customText.empty())
-    {
-        msg["Context"] = userSub->customText;
-    }
+        // Context is set by user during Event subscription and it must be
+        // set for MetricReport response.
+        if (!userSub->customText.empty())
+        {
+            msg["Context"] = userSub->customText;
+        }
 
-    std::string strMsg =
-        msg.dump(2, ' ', true, nlohmann::json::error_handler_t::replace);
-    sendEventToSubscriber(eventId, std::move(strMsg));
+        payload = payloads.reports
+                      .emplace(userSub->customText, serializeEvent(msg))
+                      .first;
+    }
+    sendEventToSubscriber(eventId, payload->second);
 }
 
 void Subscription::updateRetryConfig(uint32_t retryAttempts,
@@ -324,6 +537,16 @@ bool Subscription::matchSseId(const crow::sse_socket::Connection& thisConn)
     return &thisConn == sseConn;
 }
 
+std::optional<crow::ConnectionPoolStatistics>
+    Subscription::getDeliveryStatistics() const
+{
+    if (!client)
+    {
+        return std::nullopt;
+    }
+    return client->getStatistics();
+}
+
 // Check used to indicate what response codes are valid as part of our retry
 // policy.  2XX is considered acceptable
 boost::system::error_code Subscription::retryRespHandler(unsigned int respCode)
@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+
+# Script to generate the static route table
+# Scans the sources for BMCWEB_ROUTE registrations, keeps the urls that have no
+# parameters, and writes them to a generated .hpp file along with a minimal
+# perfect hash over them.  The router uses the table to resolve those urls
+# without walking its trie.  Run by meson at build time.
+
+import argparse
+import os
+import re
+
+ROUTE_RE = re.compile(r'BMCWEB_ROUTE\(\s*\w+\s*,\s*((?:"[^"\n]*"\s*)+)\)')
+LITERAL_RE = re.compile(r'"([^"\n]*)"')
+
+FNV_OFFSET = 2166136261
+FNV_PRIME = 16777619
+
+# Keys per first level bucket.  Smaller buckets make the displacement search
+# faster at the cost of a larger table.
+BUCKET_SIZE = 4
+
+
+def fnv1a(url, seed):
+    h = (FNV_OFFSET ^ seed) & 0xFFFFFFFF
+    for c in url.encode():
+        h ^= c
+        h = (h * FNV_PRIME) & 0xFFFFFFFF
+    return h
+
+
+def find_sources(directories):
+    sources = []
+    for directory in directories:
+        for root, dirs, files in os.walk(directory):
+            dirs.sort()
+            for filename in sorted(files):
+                if filename.endswith((".hpp", ".cpp")):
+                    sources.append(os.path.join(root, filename))
+    return sources
+
+
+def find_static_routes(sources):
+    urls = set()
+    for source in sources:
+        with open(source, encoding="utf-8") as source_file:
+            contents = source_file.read()
+        for match in ROUTE_RE.finditer(contents):
+            url = "".join(LITERAL_RE.findall(match.group(1)))
+            if "<" in url or not url.startswith("/"):
+                continue
+            urls.add(url)
+            # The router also matches a directory route without its trailing
+            # slash
+            if len(url) > 2 and url.endswith("/"):
+                urls.add(url[:-1])
+    return sorted(urls)
+
+
+# Hash and displace: each url's first level bucket holds the seed that places
+# it in its own slot of the second level table
+def build_perfect_hash(urls):
+    bucket_count = max(1, len(urls) // BUCKET_SIZE)
+    slot_count = max(1, len(urls))
+    while True:
+        buckets = [[] for _ in range(bucket_count)]
+        for index, url in enumerate(urls):
+            buckets[fnv1a(url, 0) % bucket_count].append(index)
+
+        seeds = [0] * bucket_count
+        slots = [None] * slot_count
+        failed = False
+        for bucket in sorted(
+            range(bucket_count), key=lambda b: len(buckets[b]), reverse=True
+        ):
+            if not buckets[bucket]:
+                break
+            for seed in range(1, 1 << 20):
+                placed = [
+                    fnv1a(urls[index], seed) % slot_count
+                    for index in buckets[bucket]
+                ]
+                if len(set(placed)) != len(placed):
+                    continue
+                if any(slots[slot] is not None for slot in placed):
+                    continue
+                for slot, index in zip(placed, buckets[bucket]):
+                    slots[slot] = index
+                seeds[bucket] = seed
+                break
+            else:
+                failed = True
+                break
+        if not failed:
+            return seeds, [0 if slot is None else slot for slot in slots]
+        slot_count += max(1, slot_count // 8)
+
+
+def write_header(output, urls, seeds, slots):
+    with open(output, "w", encoding="utf-8") as hpp_file:
+        hpp_file.write(
+            "// SPDX-License-Identifier: Apache-2.0\n"
+            "// SPDX-FileCopyrightText: Copyright OpenBMC Authors\n"
+            "#pragma once\n"
+            "// This is an auto-generated header, written at build time by\n"
+            "// scripts/generate_static_routes.py.  Do not modify it.\n"
+            "// clang-format off\n"
+            "#include <array>\n"
+            "#include <cstddef>\n"
+            "#include <cstdint>\n"
+            "#include <optional>\n"
+            "#include <string_view>\n"
+            "\n"
+            "namespace crow::static_routes\n"
+            "{\n"
+        )
+        hpp_file.write(
+            "constexpr std::array<std::string_view, {}> urls{{\n".format(
+                len(urls)
+            )
+        )
+        for url in urls:
+            hpp_file.write('    "{}",\n'.format(url))
+        hpp_file.write("};\n\n")
+
+        hpp_file.write(
+            "constexpr std::array<uint32_t, {}> seeds{{\n".format(len(seeds))
+        )
+        for seed in seeds:
+            hpp_file.write("    {},\n".format(seed))
+        hpp_file.write("};\n\n")
+
+        hpp_file.write(
+            "constexpr std::array<uint16_t, {}> slots{{\n".format(len(slots))
+        )
+        for slot in slots:
+            hpp_file.write("    {},\n".format(slot))
+        hpp_file.write("};\n\n")
+
+        hpp_file.write(
+            "constexpr uint32_t hash(std::string_view url, uint32_t seed)\n"
+            "{{\n"
+            "    uint32_t h = {}U ^ seed;\n"
+            "    for (char c : url)\n"
+            "    {{\n"
+            "        h ^= static_cast<unsigned char>(c);\n"
+            "        h *= {}U;\n"
+            "    }}\n"
+            "    return h;\n"
+            "}}\n"
+            "\n".format(FNV_OFFSET, FNV_PRIME)
+        )
+        hpp_file.write(
+            "// Returns the index of url in urls, if it's one of them\n"
+            "constexpr std::optional<size_t> find(std::string_view url)\n"
+            "{\n"
+            "    if constexpr (urls.empty())\n"
+            "    {\n"
+            "        return std::nullopt;\n"
+            "    }\n"
+            "    uint32_t seed = seeds[hash(url, 0U) % seeds.size()];\n"
+            "    size_t index = slots[hash(url, seed) % slots.size()];\n"
+            "    if (index >= urls.size() || urls[index] != url)\n"
+            "    {\n"
+            "        return std::nullopt;\n"
+            "    }\n"
+            "    return index;\n"
+            "}\n"
+            "} // namespace crow::static_routes\n"
+        )
+
+
+def write_depfile(depfile, output, sources):
+    with open(depfile, "w", encoding="utf-8") as dep_file:
+        dep_file.write(
+            "{}: {}\n".format(
+                output.replace(" ", "\\ "),
+                " ".join(source.replace(" ", "\\ ") for source in sources),
+            )
+        )
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--output", required=True)
+    parser.add_argument("--depfile")
+    parser.add_argument("directories", nargs="+")
+    args = parser.parse_args()
+
+    sources = find_sources(args.directories)
+    urls = find_static_routes(sources)
+    seeds, slots = build_perfect_hash(urls)
+    write_header(args.output, urls, seeds, slots)
+    if args.depfile:
+        write_depfile(args.depfile, args.output, sources)
+
+
+if __name__ == "__main__":
+    main()
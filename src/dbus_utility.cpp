@@ -3,24 +3,37 @@
 
 #include "dbus_utility.hpp"
 
+#include "bmcweb_config.h"
+
 #include "boost_formatters.hpp"
+#include "dbus_call_coalescer.hpp"
+#include "dbus_object_cache.hpp"
 #include "dbus_singleton.hpp"
+#include "io_context_singleton.hpp"
 #include "logging.hpp"
+#include "object_mapper_mirror.hpp"
 
+#include <boost/asio/post.hpp>
 #include <boost/system/error_code.hpp>
 #include <sdbusplus/asio/connection.hpp>
 #include <sdbusplus/asio/property.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
 #include <sdbusplus/message/native_types.hpp>
 
 #include <array>
 #include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <map>
+#include <memory>
+#include <optional>
 #include <regex>
 #include <span>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 namespace dbus
 {
@@ -69,11 +82,78 @@ bool getNthStringFromPath(const std::string& path, int index,
     return count >= index;
 }
 
+// Subscribes to the signals that invalidate the cached objects of a service.
+// Subscriptions are made once per service and kept for the life of the
+// process.
+static void watchServiceForCache(const std::string& service)
+{
+    static std::map<std::string, std::vector<sdbusplus::bus::match_t>,
+                    std::less<>>
+        watches;
+    if (watches.contains(service))
+    {
+        return;
+    }
+    auto invalidate = [service](sdbusplus::message_t& /*msg*/) {
+        BMCWEB_LOG_DEBUG("Invalidating cached objects for {}", service);
+        DbusObjectCache::getInstance().invalidateService(service);
+    };
+
+    namespace rules = sdbusplus::bus::match::rules;
+    std::vector<sdbusplus::bus::match_t>& serviceWatches = watches[service];
+    serviceWatches.emplace_back(
+        *crow::connections::systemBus,
+        rules::type::signal() + rules::sender(service) +
+            rules::interface("org.freedesktop.DBus.Properties") +
+            rules::member("PropertiesChanged"),
+        invalidate);
+    serviceWatches.emplace_back(
+        *crow::connections::systemBus,
+        rules::type::signal() + rules::sender(service) +
+            rules::interface("org.freedesktop.DBus.ObjectManager"),
+        invalidate);
+    serviceWatches.emplace_back(*crow::connections::systemBus,
+                                rules::nameOwnerChanged(service), invalidate);
+}
+
 void getAllProperties(const std::string& service, const std::string& objectPath,
                       const std::string& interface,
                       std::function<void(const boost::system::error_code&,
                                          const DBusPropertiesMap&)>&& callback)
 {
+    if constexpr (BMCWEB_DBUS_PROPERTY_CACHE)
+    {
+        DbusObjectCache& cache = DbusObjectCache::getInstance();
+        std::shared_ptr<const DBusPropertiesMap> cached =
+            cache.findProperties(service, objectPath, interface);
+        if (cached)
+        {
+            // Keep the callback asynchronous, as it would be for a D-Bus
+            // reply
+            boost::asio::post(getIoContext(), [callback = std::move(callback),
+                                               cached = std::move(cached)]() {
+                callback(boost::system::error_code(), *cached);
+            });
+            return;
+        }
+        watchServiceForCache(service);
+        uint64_t generation = cache.getGeneration(service);
+        sdbusplus::asio::getAllProperties(
+            *crow::connections::systemBus, service, objectPath, interface,
+            [service, objectPath, interface, generation,
+             callback = std::move(callback)](
+                const boost::system::error_code& ec,
+                const DBusPropertiesMap& properties) {
+                if (!ec)
+                {
+                    DbusObjectCache::getInstance().insertProperties(
+                        service, objectPath, interface, properties,
+                        generation);
+                }
+                callback(ec, properties);
+            });
+        return;
+    }
     sdbusplus::asio::getAllProperties(*crow::connections::systemBus, service,
                                       objectPath, interface,
                                       std::move(callback));
@@ -88,6 +168,49 @@ void getAllProperties(sdbusplus::asio::connection& /*conn*/,
     getAllProperties(service, objectPath, interface, std::move(callback));
 }
 
+// Delivers a result computed locally through the io_context, so callers see
+// the same ordering as they would for a D-Bus reply.
+template <typename Result>
+static void postResult(
+    std::function<void(const boost::system::error_code&, const Result&)>&&
+        callback,
+    Result result)
+{
+    boost::asio::post(getIoContext(), [callback = std::move(callback),
+                                       result = std::move(result)]() {
+        callback(boost::system::error_code(), result);
+    });
+}
+
+static MapperGetSubTreePathsResponse toPaths(
+    const MapperGetSubTreeResponse& subtree)
+{
+    MapperGetSubTreePathsResponse paths;
+    paths.reserve(subtree.size());
+    for (const auto& [path, services] : subtree)
+    {
+        paths.emplace_back(path);
+    }
+    return paths;
+}
+
+// Fetches the endpoints of an association into the object mapper mirror, so
+// that later association queries can be answered locally.
+static void mirrorEndPoints(const std::string& path)
+{
+    getProperty<MapperEndPoints>(
+        "xyz.openbmc_project.ObjectMapper", path,
+        "xyz.openbmc_project.Association", "endpoints",
+        [path](const boost::system::error_code& ec,
+               const MapperEndPoints& endpoints) {
+            if (!ec)
+            {
+                ObjectMapperMirror::getInstance().setEndPoints(path,
+                                                               endpoints);
+            }
+        });
+}
+
 void checkDbusPathExists(const std::string& path,
                          std::function<void(bool)>&& callback)
 {
@@ -107,6 +230,20 @@ void getSubTree(const std::string& path, int32_t depth,
                 std::function<void(const boost::system::error_code&,
                                    const MapperGetSubTreeResponse&)>&& callback)
 {
+    if constexpr (BMCWEB_OBJECT_MAPPER_MIRROR)
+    {
+        ObjectMapperMirror& mirror = ObjectMapperMirror::getInstance();
+        if (mirror.isCurrent())
+        {
+            std::optional<MapperGetSubTreeResponse> subtree =
+                mirror.getSubTree(path, depth, interfaces);
+            if (subtree)
+            {
+                postResult(std::move(callback), std::move(*subtree));
+                return;
+            }
+        }
+    }
     crow::connections::systemBus->async_method_call(
         [callback{std::move(callback)}](
             const boost::system::error_code& ec,
@@ -123,6 +260,20 @@ void getSubTreePaths(
     std::function<void(const boost::system::error_code&,
                        const MapperGetSubTreePathsResponse&)>&& callback)
 {
+    if constexpr (BMCWEB_OBJECT_MAPPER_MIRROR)
+    {
+        ObjectMapperMirror& mirror = ObjectMapperMirror::getInstance();
+        if (mirror.isCurrent())
+        {
+            std::optional<MapperGetSubTreeResponse> subtree =
+                mirror.getSubTree(path, depth, interfaces);
+            if (subtree)
+            {
+                postResult(std::move(callback), toPaths(*subtree));
+                return;
+            }
+        }
+    }
     crow::connections::systemBus->async_method_call(
         [callback{std::move(callback)}](
             const boost::system::error_code& ec,
@@ -142,6 +293,25 @@ void getAssociatedSubTree(
     std::function<void(const boost::system::error_code&,
                        const MapperGetSubTreeResponse&)>&& callback)
 {
+    if constexpr (BMCWEB_OBJECT_MAPPER_MIRROR)
+    {
+        ObjectMapperMirror& mirror = ObjectMapperMirror::getInstance();
+        if (mirror.isCurrent())
+        {
+            std::optional<MapperGetSubTreeResponse> subtree =
+                mirror.getAssociatedSubTree(associatedPath.str, path.str, depth,
+                                            interfaces);
+            if (subtree)
+            {
+                postResult(std::move(callback), std::move(*subtree));
+                return;
+            }
+            if (mirror.getEndPoints(associatedPath.str) == nullptr)
+            {
+                mirrorEndPoints(associatedPath.str);
+            }
+        }
+    }
     crow::connections::systemBus->async_method_call(
         [callback{std::move(callback)}](
             const boost::system::error_code& ec,
@@ -159,6 +329,25 @@ void getAssociatedSubTreePaths(
     std::function<void(const boost::system::error_code&,
                        const MapperGetSubTreePathsResponse&)>&& callback)
 {
+    if constexpr (BMCWEB_OBJECT_MAPPER_MIRROR)
+    {
+        ObjectMapperMirror& mirror = ObjectMapperMirror::getInstance();
+        if (mirror.isCurrent())
+        {
+            std::optional<MapperGetSubTreeResponse> subtree =
+                mirror.getAssociatedSubTree(associatedPath.str, path.str, depth,
+                                            interfaces);
+            if (subtree)
+            {
+                postResult(std::move(callback), toPaths(*subtree));
+                return;
+            }
+            if (mirror.getEndPoints(associatedPath.str) == nullptr)
+            {
+                mirrorEndPoints(associatedPath.str);
+            }
+        }
+    }
     crow::connections::systemBus->async_method_call(
         [callback{std::move(callback)}](
             const boost::system::error_code& ec,
@@ -179,6 +368,27 @@ void getAssociatedSubTreeById(
     std::function<void(const boost::system::error_code&,
                        const MapperGetSubTreeResponse&)>&& callback)
 {
+    if constexpr (BMCWEB_OBJECT_MAPPER_MIRROR)
+    {
+        ObjectMapperMirror& mirror = ObjectMapperMirror::getInstance();
+        if (mirror.isCurrent())
+        {
+            std::vector<std::string> missingEndPoints;
+            std::optional<MapperGetSubTreeResponse> subtree =
+                mirror.getAssociatedSubTreeById(
+                    id, path, subtreeInterfaces, association,
+                    endpointInterfaces, missingEndPoints);
+            if (subtree)
+            {
+                postResult(std::move(callback), std::move(*subtree));
+                return;
+            }
+            for (const std::string& endpointsPath : missingEndPoints)
+            {
+                mirrorEndPoints(endpointsPath);
+            }
+        }
+    }
     crow::connections::systemBus->async_method_call(
         [callback{std::move(callback)}](
             const boost::system::error_code& ec,
@@ -197,6 +407,27 @@ void getAssociatedSubTreePathsById(
     std::function<void(const boost::system::error_code&,
                        const MapperGetSubTreePathsResponse&)>&& callback)
 {
+    if constexpr (BMCWEB_OBJECT_MAPPER_MIRROR)
+    {
+        ObjectMapperMirror& mirror = ObjectMapperMirror::getInstance();
+        if (mirror.isCurrent())
+        {
+            std::vector<std::string> missingEndPoints;
+            std::optional<MapperGetSubTreeResponse> subtree =
+                mirror.getAssociatedSubTreeById(
+                    id, path, subtreeInterfaces, association,
+                    endpointInterfaces, missingEndPoints);
+            if (subtree)
+            {
+                postResult(std::move(callback), toPaths(*subtree));
+                return;
+            }
+            for (const std::string& endpointsPath : missingEndPoints)
+            {
+                mirrorEndPoints(endpointsPath);
+            }
+        }
+    }
     crow::connections::systemBus->async_method_call(
         [callback{std::move(callback)}](
             const boost::system::error_code& ec,
@@ -245,16 +476,92 @@ void getAssociationEndPoints(
     std::function<void(const boost::system::error_code&,
                        const MapperEndPoints&)>&& callback)
 {
+    if constexpr (BMCWEB_OBJECT_MAPPER_MIRROR)
+    {
+        const MapperEndPoints* endpoints =
+            ObjectMapperMirror::getInstance().getEndPoints(path);
+        if (endpoints != nullptr)
+        {
+            postResult(std::move(callback), MapperEndPoints(*endpoints));
+            return;
+        }
+        getProperty<MapperEndPoints>(
+            "xyz.openbmc_project.ObjectMapper", path,
+            "xyz.openbmc_project.Association", "endpoints",
+            [path, callback = std::move(callback)](
+                const boost::system::error_code& ec,
+                const MapperEndPoints& endpointsIn) {
+                if (!ec)
+                {
+                    ObjectMapperMirror::getInstance().setEndPoints(
+                        path, endpointsIn);
+                }
+                callback(ec, endpointsIn);
+            });
+        return;
+    }
     getProperty<MapperEndPoints>("xyz.openbmc_project.ObjectMapper", path,
                                  "xyz.openbmc_project.Association", "endpoints",
                                  std::move(callback));
 }
 
+// Sibling resources of an $expand, and concurrent requests in general, tend
+// to ask a service for the same objects at the same time.  They share one call
+// when the service hasn't signalled a change since it was sent.  That relies
+// on the same signal watch as the cache, so calls are only shared when the
+// cache is enabled.
+static DbusCallCoalescer<ManagedObjectType>& getManagedObjectsCalls()
+{
+    static DbusCallCoalescer<ManagedObjectType> calls;
+    return calls;
+}
+
 void getManagedObjects(const std::string& service,
                        const sdbusplus::message::object_path& path,
                        std::function<void(const boost::system::error_code&,
                                           const ManagedObjectType&)>&& callback)
 {
+    if constexpr (BMCWEB_DBUS_PROPERTY_CACHE)
+    {
+        std::shared_ptr<const ManagedObjectType> cached =
+            DbusObjectCache::getInstance().findManagedObjects(service,
+                                                              path.str);
+        if (cached)
+        {
+            boost::asio::post(getIoContext(), [callback = std::move(callback),
+                                               cached = std::move(cached)]() {
+                callback(boost::system::error_code(), *cached);
+            });
+            return;
+        }
+
+        watchServiceForCache(service);
+        uint64_t generation = DbusObjectCache::getInstance().getGeneration(
+            service);
+        DbusCallCoalescer<ManagedObjectType>::Key key(service, path.str);
+        std::shared_ptr<DbusCallCoalescer<ManagedObjectType>::Call> call =
+            getManagedObjectsCalls().join(key, generation, std::move(callback));
+        if (call == nullptr)
+        {
+            BMCWEB_LOG_DEBUG("Joined GetManagedObjects {} {} in flight",
+                             service, path.str);
+            return;
+        }
+        crow::connections::systemBus->async_method_call(
+            [key = std::move(key), call = std::move(call)](
+                const boost::system::error_code& ec,
+                const ManagedObjectType& objects) {
+                if (!ec)
+                {
+                    DbusObjectCache::getInstance().insertManagedObjects(
+                        key.first, key.second, objects, call->generation);
+                }
+                getManagedObjectsCalls().complete(key, call, ec, objects);
+            },
+            service, path, "org.freedesktop.DBus.ObjectManager",
+            "GetManagedObjects");
+        return;
+    }
     crow::connections::systemBus->async_method_call(
         [callback{std::move(callback)}](const boost::system::error_code& ec,
                                         const ManagedObjectType& objects) {
@@ -20,11 +20,14 @@ extern "C"
 #include <nghttp2/nghttp2.h>
 #include <openssl/asn1.h>
 #include <openssl/bio.h>
+#include <openssl/core_names.h>
 #include <openssl/ec.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <openssl/obj_mac.h>
+#include <openssl/params.h>
 #include <openssl/pem.h>
+#include <openssl/rand.h>
 #include <openssl/ssl.h>
 #include <openssl/tls1.h>
 #include <openssl/types.h>
@@ -33,14 +36,19 @@ extern "C"
 #include <openssl/x509v3.h>
 }
 
+#include <algorithm>
+#include <array>
 #include <bit>
+#include <chrono>
 #include <cstddef>
 #include <filesystem>
 #include <limits>
 #include <memory>
 #include <optional>
 #include <random>
+#include <span>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <utility>
 
@@ -532,6 +540,201 @@ static bool getSslContext(boost::asio::ssl::context& mSslContext,
     return true;
 }
 
+namespace
+{
+
+// Keys that session tickets handed to clients are encrypted with
+struct TicketKey
+{
+    std::array<unsigned char, 16> name{};
+    std::array<unsigned char, 32> aesKey{};
+    std::array<unsigned char, 32> hmacKey{};
+    std::chrono::steady_clock::time_point created;
+};
+
+// New tickets are encrypted with the current key.  The previous key is still
+// accepted, so that a rotation doesn't invalidate the tickets just handed out,
+// and a client using it is sent a new ticket.
+struct TicketKeys
+{
+    std::optional<TicketKey> current;
+    std::optional<TicketKey> previous;
+};
+
+} // namespace
+
+// A ticket lives at most two key lifetimes: as current then previous key
+constexpr std::chrono::seconds ticketKeyLifetime = std::chrono::hours(1);
+
+// Sessions kept for TLS 1.2 clients that resume by session ID
+constexpr long tlsSessionCacheSize = 1024;
+
+static TicketKeys& getTicketKeys()
+{
+    static TicketKeys keys;
+    return keys;
+}
+
+static std::optional<TicketKey> generateTicketKey()
+{
+    TicketKey key;
+    if (RAND_bytes(key.name.data(), static_cast<int>(key.name.size())) != 1 ||
+        RAND_bytes(key.aesKey.data(), static_cast<int>(key.aesKey.size())) !=
+            1 ||
+        RAND_bytes(key.hmacKey.data(), static_cast<int>(key.hmacKey.size())) !=
+            1)
+    {
+        BMCWEB_LOG_ERROR("Failed to generate TLS ticket key");
+        return std::nullopt;
+    }
+    key.created = std::chrono::steady_clock::now();
+    return key;
+}
+
+static bool setTicketHmacKey(EVP_MAC_CTX* macCtx, TicketKey& key)
+{
+    std::string digest = "SHA256";
+    std::array<OSSL_PARAM, 3> params{
+        OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY,
+                                          key.hmacKey.data(),
+                                          key.hmacKey.size()),
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest.data(),
+                                         0),
+        OSSL_PARAM_construct_end()};
+    return EVP_MAC_CTX_set_params(macCtx, params.data()) == 1;
+}
+
+static int ticketKeyCallback(SSL* /*ssl*/, unsigned char* keyName,
+                             unsigned char* iv, EVP_CIPHER_CTX* cipherCtx,
+                             EVP_MAC_CTX* macCtx, int encrypt)
+{
+    TicketKeys& keys = getTicketKeys();
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    if (!keys.current || now - keys.current->created >= ticketKeyLifetime)
+    {
+        std::optional<TicketKey> key = generateTicketKey();
+        if (!key)
+        {
+            return -1;
+        }
+        BMCWEB_LOG_DEBUG("Rotating TLS ticket key");
+        keys.previous = std::move(keys.current);
+        keys.current = std::move(key);
+    }
+
+    if (encrypt == 1)
+    {
+        TicketKey& key = *keys.current;
+        constexpr int ivLength = 16;
+        if (RAND_bytes(iv, ivLength) != 1)
+        {
+            return -1;
+        }
+        std::ranges::copy(key.name, keyName);
+        if (EVP_EncryptInit_ex(cipherCtx, EVP_aes_256_cbc(), nullptr,
+                               key.aesKey.data(), iv) != 1 ||
+            !setTicketHmacKey(macCtx, key))
+        {
+            return -1;
+        }
+        return 1;
+    }
+
+    int ret = 1;
+    TicketKey* key = &*keys.current;
+    if (!std::ranges::equal(std::span(keyName, key->name.size()), key->name))
+    {
+        if (!keys.previous ||
+            !std::ranges::equal(std::span(keyName, keys.previous->name.size()),
+                                keys.previous->name) ||
+            now - keys.previous->created >= 2 * ticketKeyLifetime)
+        {
+            // Unknown or expired key, fall back to a full handshake
+            return 0;
+        }
+        key = &*keys.previous;
+        // Ask for the ticket to be renewed with the current key
+        ret = 2;
+    }
+    if (EVP_DecryptInit_ex(cipherCtx, EVP_aes_256_cbc(), nullptr,
+                           key->aesKey.data(), iv) != 1 ||
+        !setTicketHmacKey(macCtx, *key))
+    {
+        return -1;
+    }
+    return ret;
+}
+
+static void setupSessionResumption(boost::asio::ssl::context& sslCtx)
+{
+    SSL_CTX* ctx = sslCtx.native_handle();
+
+    // Tickets issued before a reload might carry an identity or settings that
+    // no longer apply, so start over with new keys
+    getTicketKeys() = TicketKeys{};
+    SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, ticketKeyCallback);
+
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER);
+    SSL_CTX_sess_set_cache_size(ctx, tlsSessionCacheSize);
+    SSL_CTX_set_timeout(ctx, static_cast<long>(ticketKeyLifetime.count()));
+
+    // Sessions are only resumed in a matching context, which is required
+    // when client certificates are verified
+    constexpr std::string_view id = "bmcweb";
+    SSL_CTX_set_session_id_context(
+        ctx, std::bit_cast<const unsigned char*>(id.data()),
+        static_cast<unsigned int>(id.size()));
+}
+
+TlsStatistics& getServerTlsStatistics()
+{
+    static TlsStatistics stats;
+    return stats;
+}
+
+TlsStatistics& getClientTlsStatistics()
+{
+    static TlsStatistics stats;
+    return stats;
+}
+
+void countHandshake(TlsStatistics& stats, SSL* ssl)
+{
+    stats.handshakes++;
+    if (SSL_session_reused(ssl) == 1)
+    {
+        stats.resumedHandshakes++;
+    }
+}
+
+void ClientSessionCache::apply(SSL* ssl) const
+{
+    if (session == nullptr)
+    {
+        return;
+    }
+    if (SSL_set_session(ssl, session.get()) != 1)
+    {
+        BMCWEB_LOG_DEBUG("Failed to offer cached TLS session");
+    }
+}
+
+void ClientSessionCache::save(SSL* ssl)
+{
+    SSL_SESSION* newSession = SSL_get1_session(ssl);
+    if (newSession == nullptr)
+    {
+        return;
+    }
+    if (SSL_SESSION_is_resumable(newSession) != 1)
+    {
+        SSL_SESSION_free(newSession);
+        return;
+    }
+    session.reset(newSession, SSL_SESSION_free);
+}
+
 std::shared_ptr<boost::asio::ssl::context> getSslServerContext()
 {
     boost::asio::ssl::context sslCtx(boost::asio::ssl::context::tls_server);
@@ -562,6 +765,8 @@ std::shared_ptr<boost::asio::ssl::context> getSslServerContext()
 
     SSL_CTX_set_options(sslCtx.native_handle(), SSL_OP_NO_RENEGOTIATION);
 
+    setupSessionResumption(sslCtx);
+
     if constexpr (BMCWEB_EXPERIMENTAL_HTTP2)
     {
         SSL_CTX_set_next_protos_advertised_cb(sslCtx.native_handle(),
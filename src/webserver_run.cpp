@@ -6,9 +6,11 @@
 
 #include "app.hpp"
 #include "dbus_monitor.hpp"
+#include "dbus_object_cache.hpp"
 #include "dbus_singleton.hpp"
 #include "event_service_manager.hpp"
 #include "google/google_service_root.hpp"
+#include "gzip_compressor.hpp"
 #include "hostname_monitor.hpp"
 #include "ibm/locks.hpp"
 #include "ibm/management_console_rest.hpp"
@@ -17,6 +19,7 @@
 #include "kvm_websocket.hpp"
 #include "logging.hpp"
 #include "login_routes.hpp"
+#include "object_mapper_monitor.hpp"
 #include "obmc_console.hpp"
 #include "obmc_hypervisor.hpp"
 #include "obmc_shell.hpp"
@@ -24,20 +27,26 @@
 #include "persistent_data.hpp"
 #include "redfish.hpp"
 #include "redfish_aggregator.hpp"
+#include "user_info_cache.hpp"
 #include "user_monitor.hpp"
 #include "vm_websocket.hpp"
 #include "watchdog.hpp"
 #include "webassets.hpp"
 
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <event_dbus_monitor.hpp>
 #include <sdbusplus/asio/connection.hpp>
 #include <sdbusplus/asio/object_server.hpp>
+#include <sdbusplus/vtable.hpp>
 
 #include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <utility>
 
 static void setLogLevel(const std::string& logLevel)
 {
@@ -55,6 +64,14 @@ static void setLogLevel(const std::string& logLevel)
 int run()
 {
     boost::asio::io_context& io = getIoContext();
+
+    // Write out log lines once the handlers that are ready have run, rather
+    // than flushing stdout after every line
+    crow::LogFlusher::getInstance().setScheduler(
+        [&io](std::function<void()>&& flush) {
+            boost::asio::post(io, std::move(flush));
+        });
+
     App app;
 
     std::shared_ptr<sdbusplus::asio::connection> systemBus =
@@ -69,6 +86,32 @@ int run()
 
     iface->register_method("SetLogLevel", setLogLevel);
 
+    iface->register_property_r<double>(
+        "UserInfoCacheHitRatio", 0.0, sdbusplus::vtable::property_::none,
+        [](const double&) {
+            return crow::UserInfoCache::getInstance().getHitRatio();
+        });
+    iface->register_property_r<uint64_t>(
+        "UserInfoCacheHits", 0, sdbusplus::vtable::property_::none,
+        [](const uint64_t&) {
+            return crow::UserInfoCache::getInstance().getHits();
+        });
+    iface->register_property_r<uint64_t>(
+        "UserInfoCacheMisses", 0, sdbusplus::vtable::property_::none,
+        [](const uint64_t&) {
+            return crow::UserInfoCache::getInstance().getMisses();
+        });
+    iface->register_property_r<double>(
+        "ResponseCompressionRatio", 0.0, sdbusplus::vtable::property_::none,
+        [](const double&) {
+            return bmcweb::CompressionStatistics::getInstance().ratio();
+        });
+    iface->register_property_r<double>(
+        "DbusCacheHitRatio", 0.0, sdbusplus::vtable::property_::none,
+        [](const double&) {
+            return dbus::utility::DbusObjectCache::getInstance().getHitRatio();
+        });
+
     iface->initialize();
 
     // Load the peristent data
@@ -165,6 +208,11 @@ int run()
 
     bmcweb::registerUserRemovedSignal();
 
+    if constexpr (BMCWEB_OBJECT_MAPPER_MIRROR)
+    {
+        bmcweb::registerObjectMapperMirror();
+    }
+
     bmcweb::ServiceWatchdog watchdog;
 
     app.run();
@@ -173,6 +221,7 @@ int run()
 
     io.run();
 
+    crow::LogFlusher::getInstance().setScheduler(nullptr);
     crow::connections::systemBus = nullptr;
 
     return 0;
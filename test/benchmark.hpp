@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace bmcweb
+{
+
+// Calls func iterations times and returns the mean time of one call, counted
+// in Duration units, e.g. timePerIteration<std::chrono::microseconds>(...)
+template <typename Duration, typename Func>
+double timePerIteration(size_t iterations, Func&& func)
+{
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        func();
+    }
+    std::chrono::duration<double, typename Duration::period> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / static_cast<double>(iterations);
+}
+
+} // namespace bmcweb
@@ -3,14 +3,25 @@
 #include "file_test_utilities.hpp"
 #include "http_body.hpp"
 
+#include <zlib.h>
+
+#include <boost/asio/buffer.hpp>
 #include <boost/beast/core/file_base.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/optional/optional.hpp>
 #include <boost/system/error_code.hpp>
+#include <nlohmann/json.hpp>
 
 #include <array>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
+#include <memory>
+#include <optional>
 #include <span>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include <gmock/gmock.h>
@@ -133,5 +144,197 @@ TEST(HttpFileBodyValueType, SetFd)
     EXPECT_EQ(value.payloadSize(), 16);
 }
 
+TEST(HttpBodyWriter, StreamsJson)
+{
+    nlohmann::json json = {{"Members", nlohmann::json::array()}};
+    for (int i = 0; i < 1000; i++)
+    {
+        json["Members"].push_back({{"@odata.id", "/redfish/v1/Item"}});
+    }
+    boost::beast::http::response<HttpBody> res;
+    res.body().setJson(std::make_shared<const nlohmann::json>(json), 2);
+    EXPECT_EQ(res.body().payloadSize(), std::nullopt);
+
+    HttpBody::writer writer(res.base(), res.body());
+    boost::beast::error_code ec;
+    std::string out;
+    bool more = true;
+    while (more)
+    {
+        auto ret = writer.getWithMaxSize(ec, 100);
+        ASSERT_FALSE(ec);
+        ASSERT_TRUE(ret);
+        EXPECT_LE(ret->first.size(), 100U);
+        out += std::string_view(static_cast<const char*>(ret->first.data()),
+                                ret->first.size());
+        more = ret->second;
+    }
+    EXPECT_EQ(out, json.dump(2));
+}
+
+TEST(HttpBodyWriter, StreamsCompactJson)
+{
+    nlohmann::json json = {{"Name", "Test \"quoted\""}, {"Id", 1}};
+    boost::beast::http::response<HttpBody> res;
+    res.body().setJson(std::make_shared<const nlohmann::json>(json), -1);
+
+    HttpBody::writer writer(res.base(), res.body());
+    boost::beast::error_code ec;
+    auto ret = writer.get(ec);
+    ASSERT_FALSE(ec);
+    ASSERT_TRUE(ret);
+    EXPECT_FALSE(ret->second);
+    EXPECT_EQ(std::string_view(static_cast<const char*>(ret->first.data()),
+                               ret->first.size()),
+              json.dump());
+}
+
+TEST(HttpBodyWriter, SharedString)
+{
+    auto shared = std::make_shared<const std::string>("sharedstring");
+    boost::beast::http::request<HttpBody> req1;
+    boost::beast::http::request<HttpBody> req2;
+    req1.body().setSharedStr(shared);
+    req2.body().setSharedStr(shared);
+    EXPECT_EQ(req1.body().payloadSize(), 12);
+
+    HttpBody::writer writer1(req1.base(), req1.body());
+    HttpBody::writer writer2(req2.base(), req2.body());
+    boost::beast::error_code ec;
+    auto ret1 = writer1.getWithMaxSize(ec, 6);
+    ASSERT_FALSE(ec);
+    ASSERT_TRUE(ret1);
+    EXPECT_TRUE(ret1->second);
+    // Both requests send from the same buffer
+    EXPECT_EQ(ret1->first.data(), shared->data());
+    auto ret2 = writer2.get(ec);
+    ASSERT_FALSE(ec);
+    ASSERT_TRUE(ret2);
+    EXPECT_FALSE(ret2->second);
+    EXPECT_EQ(ret2->first.data(), shared->data());
+    EXPECT_EQ(ret2->first.size(), 12);
+
+    ret1 = writer1.getWithMaxSize(ec, 6);
+    ASSERT_FALSE(ec);
+    ASSERT_TRUE(ret1);
+    EXPECT_FALSE(ret1->second);
+    EXPECT_EQ(std::string_view(static_cast<const char*>(ret1->first.data()),
+                               ret1->first.size()),
+              "string");
+}
+
+std::string gunzip(std::string_view compressed)
+{
+    z_stream stream{};
+    EXPECT_EQ(inflateInit2(&stream, 15 + 16), Z_OK);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    char* input = const_cast<char*>(compressed.data());
+    stream.next_in = std::bit_cast<Bytef*>(input);
+    stream.avail_in = static_cast<uInt>(compressed.size());
+    std::string out;
+    int ret = Z_OK;
+    while (ret == Z_OK)
+    {
+        std::array<char, 4096> chunk{};
+        stream.next_out = std::bit_cast<Bytef*>(chunk.data());
+        stream.avail_out = static_cast<uInt>(chunk.size());
+        ret = inflate(&stream, Z_NO_FLUSH);
+        out.append(chunk.data(), chunk.size() - stream.avail_out);
+    }
+    EXPECT_EQ(ret, Z_STREAM_END);
+    inflateEnd(&stream);
+    return out;
+}
+
+TEST(HttpBodyWriter, GzipString)
+{
+    std::string data;
+    while (data.size() < 200000)
+    {
+        data += "sample text ";
+    }
+    boost::beast::http::response<HttpBody> res;
+    res.body().str() = data;
+    res.body().compression = CompressionType::Gzip;
+    EXPECT_EQ(res.body().payloadSize(), std::nullopt);
+
+    HttpBody::writer writer(res.base(), res.body());
+    boost::beast::error_code ec;
+    std::string compressed;
+    bool more = true;
+    while (more)
+    {
+        auto ret = writer.getWithMaxSize(ec, 1000);
+        ASSERT_FALSE(ec);
+        ASSERT_TRUE(ret);
+        EXPECT_LE(ret->first.size(), 1000U);
+        compressed += std::string_view(
+            static_cast<const char*>(ret->first.data()), ret->first.size());
+        more = ret->second;
+    }
+    EXPECT_LT(compressed.size(), data.size());
+    EXPECT_EQ(gunzip(compressed), data);
+}
+
+TEST(HttpBodyWriter, GzipStreamedJson)
+{
+    nlohmann::json json = {{"Members", nlohmann::json::array()}};
+    for (int i = 0; i < 5000; i++)
+    {
+        json["Members"].push_back({{"@odata.id", "/redfish/v1/Item"}});
+    }
+    boost::beast::http::response<HttpBody> res;
+    res.body().setJson(std::make_shared<const nlohmann::json>(json), 2);
+    res.body().compression = CompressionType::Gzip;
+
+    HttpBody::writer writer(res.base(), res.body());
+    boost::beast::error_code ec;
+    std::string compressed;
+    bool more = true;
+    while (more)
+    {
+        auto ret = writer.get(ec);
+        ASSERT_FALSE(ec);
+        ASSERT_TRUE(ret);
+        compressed += std::string_view(
+            static_cast<const char*>(ret->first.data()), ret->first.size());
+        more = ret->second;
+    }
+    EXPECT_EQ(gunzip(compressed), json.dump(2));
+}
+
+TEST(HttpBodyReader, IntoFile)
+{
+    TemporaryFileHandle temporaryFile("");
+    boost::beast::http::request<HttpBody> req;
+    boost::system::error_code ec;
+    req.body().open(temporaryFile.stringPath.c_str(),
+                    boost::beast::file_mode::write, ec);
+    ASSERT_FALSE(ec);
+
+    HttpBody::reader reader(req.base(), req.body());
+    reader.init(boost::optional<std::uint64_t>(10), ec);
+    ASSERT_FALSE(ec);
+    EXPECT_EQ(reader.put(boost::asio::buffer(std::string_view("test")), ec),
+              4);
+    ASSERT_FALSE(ec);
+    EXPECT_EQ(reader.put(boost::asio::buffer(std::string_view("string")), ec),
+              6);
+    ASSERT_FALSE(ec);
+
+    // Nothing is held in memory
+    EXPECT_TRUE(req.body().str().empty());
+    EXPECT_EQ(req.body().payloadSize(), 10);
+
+    HttpBody::value_type readBack;
+    readBack.open(temporaryFile.stringPath.c_str(),
+                  boost::beast::file_mode::read, ec);
+    ASSERT_FALSE(ec);
+    std::array<char, 4096> buffer{};
+    size_t out = readBack.file().read(buffer.data(), buffer.size(), ec);
+    ASSERT_FALSE(ec);
+    EXPECT_EQ(std::string_view(buffer.data(), out), "teststring");
+}
+
 } // namespace
 } // namespace bmcweb
@@ -0,0 +1,314 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "http/http_client.hpp"
+#include "http/http_response.hpp"
+#include "ssl_key_handler.hpp"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/address.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/http/fields.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/read.hpp>
+#include <boost/beast/http/status.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/beast/http/verb.hpp>
+#include <boost/beast/http/write.hpp>
+#include <boost/system/error_code.hpp>
+#include <boost/url/format.hpp>
+#include <boost/url/url.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace crow
+{
+namespace
+{
+
+using ::testing::Each;
+
+struct Reply
+{
+    boost::beast::http::status status = boost::beast::http::status::ok;
+    bool keepAlive = true;
+    std::chrono::milliseconds delay{0};
+};
+
+// Answers requests on a local port with the replies a test picks
+class TestServer
+{
+  public:
+    explicit TestServer(boost::asio::io_context& io) :
+        acceptor(io, boost::asio::ip::tcp::endpoint(
+                         boost::asio::ip::make_address("127.0.0.1"), 0))
+    {
+        accept();
+    }
+
+    boost::urls::url url() const
+    {
+        return boost::urls::format("http://127.0.0.1:{}/events",
+                                   acceptor.local_endpoint().port());
+    }
+
+    // Picks the reply to a request, numbered from 0 over all connections
+    std::function<Reply(size_t)> reply = [](size_t /*request*/) {
+        return Reply{};
+    };
+    size_t requests = 0;
+    size_t connections = 0;
+
+  private:
+    struct Session
+    {
+        explicit Session(boost::asio::ip::tcp::socket&& socketIn) :
+            socket(std::move(socketIn)), timer(socket.get_executor())
+        {}
+
+        boost::asio::ip::tcp::socket socket;
+        boost::asio::steady_timer timer;
+        boost::beast::flat_buffer buffer;
+        boost::beast::http::request<boost::beast::http::string_body> req;
+        boost::beast::http::response<boost::beast::http::string_body> res;
+        std::array<char, 1024> discard{};
+    };
+
+    void accept()
+    {
+        acceptor.async_accept([this](const boost::system::error_code& ec,
+                                     boost::asio::ip::tcp::socket socket) {
+            if (ec)
+            {
+                return;
+            }
+            connections++;
+            read(std::make_shared<Session>(std::move(socket)));
+            accept();
+        });
+    }
+
+    void read(const std::shared_ptr<Session>& session)
+    {
+        session->req = {};
+        boost::beast::http::async_read(
+            session->socket, session->buffer, session->req,
+            [this, session](const boost::system::error_code& ec,
+                            size_t /*bytesTransferred*/) {
+                if (ec)
+                {
+                    return;
+                }
+                Reply r = reply(requests++);
+                session->res = {};
+                session->res.result(r.status);
+                session->res.version(11);
+                session->res.keep_alive(r.keepAlive);
+                session->res.prepare_payload();
+                session->timer.expires_after(r.delay);
+                session->timer.async_wait(
+                    [this, session, keepAlive = r.keepAlive](
+                        const boost::system::error_code& /*ec*/) {
+                        write(session, keepAlive);
+                    });
+            });
+    }
+
+    void write(const std::shared_ptr<Session>& session, bool keepAlive)
+    {
+        boost::beast::http::async_write(
+            session->socket, session->res,
+            [this, session, keepAlive](const boost::system::error_code& ec,
+                                       size_t /*bytesTransferred*/) {
+                if (ec)
+                {
+                    return;
+                }
+                if (keepAlive)
+                {
+                    read(session);
+                    return;
+                }
+                // Read the requests pipelined behind this one until the
+                // client closes, as closing with them unread would reset
+                // the connection before the client reads the response
+                boost::system::error_code ignored;
+                session->socket.shutdown(
+                    boost::asio::ip::tcp::socket::shutdown_send, ignored);
+                drain(session);
+            });
+    }
+
+    static void drain(const std::shared_ptr<Session>& session)
+    {
+        session->socket.async_read_some(
+            boost::asio::buffer(session->discard),
+            [session](const boost::system::error_code& ec,
+                      size_t /*bytesTransferred*/) {
+                if (!ec)
+                {
+                    drain(session);
+                }
+            });
+    }
+
+    boost::asio::ip::tcp::acceptor acceptor;
+};
+
+class HttpClientTest : public ::testing::Test
+{
+  protected:
+    HttpClientTest()
+    {
+        // Hand every response to the callback, as the aggregator does
+        policy->invalidResp = [](unsigned int /*respCode*/) {
+            return boost::system::error_code();
+        };
+    }
+
+    void send(size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            client.sendDataWithCallback(
+                std::string("{}"), server.url(),
+                ensuressl::VerifyCertificate::Verify,
+                boost::beast::http::fields(), boost::beast::http::verb::post,
+                [this](Response& res) { results.push_back(res.resultInt()); });
+        }
+    }
+
+    // Runs the io_context until count responses have come back, or gives up
+    // after a while
+    bool waitForResults(size_t count)
+    {
+        std::chrono::steady_clock::time_point deadline =
+            std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (results.size() < count)
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+            io.run_one_for(std::chrono::milliseconds(100));
+        }
+        return true;
+    }
+
+    size_t getConcurrencyLimit() const
+    {
+        return client.getStatistics().concurrencyLimit;
+    }
+
+    boost::asio::io_context io;
+    TestServer server{io};
+    std::shared_ptr<ConnectionPolicy> policy =
+        std::make_shared<ConnectionPolicy>();
+    HttpClient client{io, policy};
+    std::vector<unsigned int> results;
+};
+
+TEST_F(HttpClientTest, HalvesLimitOnFailure)
+{
+    policy->maxConnections = 4;
+    server.reply = [](size_t /*request*/) {
+        Reply r;
+        r.status = boost::beast::http::status::service_unavailable;
+        return r;
+    };
+
+    send(1);
+    ASSERT_TRUE(waitForResults(1));
+    EXPECT_EQ(getConcurrencyLimit(), 2);
+
+    send(1);
+    ASSERT_TRUE(waitForResults(2));
+    EXPECT_EQ(getConcurrencyLimit(), 1);
+
+    send(1);
+    ASSERT_TRUE(waitForResults(3));
+    EXPECT_EQ(getConcurrencyLimit(), 1);
+    EXPECT_THAT(results, Each(503));
+}
+
+TEST_F(HttpClientTest, HalvesLimitOnSlowResponse)
+{
+    policy->maxConnections = 4;
+    policy->latencyTarget = std::chrono::milliseconds(1);
+    server.reply = [](size_t /*request*/) {
+        Reply r;
+        r.delay = std::chrono::milliseconds(50);
+        return r;
+    };
+
+    send(1);
+    ASSERT_TRUE(waitForResults(1));
+    EXPECT_EQ(getConcurrencyLimit(), 2);
+    EXPECT_THAT(results, Each(200));
+}
+
+TEST_F(HttpClientTest, RaisesLimitWhileRequestsWait)
+{
+    // One connection, as for an event subscription, so the limit is the
+    // depth of the pipeline
+    policy->pipelineDepth = 4;
+    server.reply = [](size_t n) {
+        Reply r;
+        if (n < 2)
+        {
+            r.status = boost::beast::http::status::service_unavailable;
+        }
+        return r;
+    };
+
+    send(1);
+    ASSERT_TRUE(waitForResults(1));
+    send(1);
+    ASSERT_TRUE(waitForResults(2));
+    EXPECT_EQ(getConcurrencyLimit(), 1);
+
+    // Each window of successes with requests waiting raises the limit by
+    // one, up to maxConnections * pipelineDepth
+    send(8);
+    ASSERT_TRUE(waitForResults(10));
+    EXPECT_EQ(getConcurrencyLimit(), 4);
+    EXPECT_EQ(client.getStatistics().connections, 1);
+    EXPECT_EQ(server.connections, 1);
+    EXPECT_THAT(std::vector<unsigned int>(results.begin() + 2, results.end()),
+                Each(200));
+}
+
+TEST_F(HttpClientTest, ResendsPipelinedRequestsAfterEarlyClose)
+{
+    policy->pipelineDepth = 4;
+    // The server closes after answering the first of the pipelined requests
+    server.reply = [](size_t n) {
+        Reply r;
+        r.keepAlive = n != 1;
+        return r;
+    };
+
+    // The first request goes out alone, and the rest are pipelined behind
+    // its response
+    send(4);
+    ASSERT_TRUE(waitForResults(4));
+    EXPECT_THAT(results, Each(200));
+    EXPECT_EQ(server.connections, 2);
+    EXPECT_EQ(server.requests, 4);
+    EXPECT_EQ(client.getStatistics().inFlight, 0);
+}
+
+} // namespace
+} // namespace crow
@@ -19,6 +19,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "gtest/gtest.h"
@@ -37,6 +38,12 @@ struct FakeHandler
         EXPECT_FALSE(true);
     }
 
+    static bool streamsBodyToFile(boost::beast::http::verb /*method*/,
+                                  std::string_view /*path*/)
+    {
+        return false;
+    }
+
     void handle(const std::shared_ptr<Request>& req,
                 const std::shared_ptr<bmcweb::AsyncResp>& /*asyncResp*/)
     {
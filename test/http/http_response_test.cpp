@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 // SPDX-FileCopyrightText: Copyright OpenBMC Authors
 #include "file_test_utilities.hpp"
+#include "http/etag_hasher.hpp"
 #include "http/http_body.hpp"
 #include "http/http_response.hpp"
 #include "utility.hpp"
@@ -8,13 +9,16 @@
 #include <boost/beast/core/buffers_to_string.hpp>
 #include <boost/beast/core/file_base.hpp>
 #include <boost/beast/core/file_posix.hpp>
+#include <boost/beast/http/field.hpp>
 #include <boost/beast/http/message.hpp>
 #include <boost/beast/http/serializer.hpp>
 #include <boost/beast/http/status.hpp>
+#include <nlohmann/json.hpp>
 
 #include <cstdio>
 #include <filesystem>
 #include <string>
+#include <string_view>
 
 #include "gtest/gtest.h"
 namespace
@@ -184,4 +188,75 @@ TEST(HttpResponse, HttpBodyWriterLarge)
     EXPECT_EQ(getData(res.response), data);
 }
 
+TEST(HttpResponse, EtagFromSerializedBodyMatchesComputeEtag)
+{
+    crow::Response res;
+    res.result(boost::beast::http::status::ok);
+    res.jsonValue["Name"] = "Test";
+    res.jsonValue["Members"] = nlohmann::json::array({1, 2, 3});
+
+    std::string expected = res.computeEtag();
+    ASSERT_FALSE(expected.empty());
+
+    res.setHashAndHandleNotModified(res.jsonValue.dump(crow::jsonIndent));
+    EXPECT_EQ(res.getHeaderValue(boost::beast::http::field::etag), expected);
+}
+
+TEST(HttpResponse, EtagNotModified)
+{
+    crow::Response res;
+    res.result(boost::beast::http::status::ok);
+    res.jsonValue["Name"] = "Test";
+    res.setExpectedHash(res.computeEtag());
+
+    res.setHashAndHandleNotModified(res.jsonValue.dump(crow::jsonIndent));
+    EXPECT_EQ(res.result(), boost::beast::http::status::not_modified);
+    EXPECT_TRUE(res.jsonValue.is_null());
+}
+
+TEST(HttpResponse, GzipEtagIsDistinct)
+{
+    EXPECT_EQ(crow::Response::gzipEtag("\"0123ABCD\""), "\"0123ABCD-gzip\"");
+    EXPECT_TRUE(crow::Response::etagMatches("\"0123ABCD\"", "\"0123ABCD\""));
+    EXPECT_TRUE(
+        crow::Response::etagMatches("\"0123ABCD-gzip\"", "\"0123ABCD\""));
+    EXPECT_FALSE(
+        crow::Response::etagMatches("\"0123ABCE-gzip\"", "\"0123ABCD\""));
+}
+
+TEST(HttpResponse, EtagNotModifiedForGzipEtag)
+{
+    crow::Response res;
+    res.result(boost::beast::http::status::ok);
+    res.jsonValue["Name"] = "Test";
+    std::string gzipEtag = crow::Response::gzipEtag(res.computeEtag());
+    res.setExpectedHash(gzipEtag);
+
+    res.setHashAndHandleNotModified(res.jsonValue.dump(crow::jsonIndent));
+    EXPECT_EQ(res.result(), boost::beast::http::status::not_modified);
+    EXPECT_EQ(res.getHeaderValue(boost::beast::http::field::etag), gzipEtag);
+}
+
+TEST(EtagHasher, IncrementalMatchesOneShot)
+{
+    std::string data;
+    while (data.size() < bmcweb::EtagHasher::blockSize * 3)
+    {
+        data += "sample text";
+    }
+
+    bmcweb::EtagHasher oneShot;
+    oneShot.update(data);
+
+    bmcweb::EtagHasher incremental;
+    std::string_view remaining = data;
+    while (!remaining.empty())
+    {
+        std::string_view piece = remaining.substr(0, 1000);
+        incremental.update(piece);
+        remaining.remove_prefix(piece.size());
+    }
+    EXPECT_EQ(oneShot.finish(), incremental.finish());
+}
+
 } // namespace
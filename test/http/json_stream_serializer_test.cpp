@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "json_stream_serializer.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace bmcweb
+{
+namespace
+{
+
+std::string serialize(const nlohmann::json& json, int indent, size_t minBytes)
+{
+    JsonStreamSerializer serializer(json, indent);
+    std::string out;
+    while (!serializer.isDone())
+    {
+        out += serializer.next(minBytes);
+    }
+    return out;
+}
+
+TEST(JsonStreamSerializer, MatchesDump)
+{
+    nlohmann::json json = {
+        {"Null", nullptr},
+        {"Bool", true},
+        {"Unsigned", 18446744073709551615ULL},
+        {"Integer", -42},
+        {"Float", 3.25},
+        {"Unicode", "café ☃"},
+        {"Escaped", "tab\there \"quoted\" \\ \x01"},
+        {"InvalidUtf8", "bad \xff byte"},
+        {"Delete \x7f", "key and value \x7f"},
+        {"Key \"quoted\"", "value"},
+        {"EmptyObject", nlohmann::json::object()},
+        {"EmptyArray", nlohmann::json::array()},
+        {"Nested", {{"Array", {1, "two", {{"three", 3}}}}}},
+    };
+    for (int indent : {-1, 0, 2, 4})
+    {
+        std::string expected = json.dump(
+            indent, ' ', true, nlohmann::json::error_handler_t::replace);
+        EXPECT_EQ(serialize(json, indent, 1), expected);
+        EXPECT_EQ(serialize(json, indent, 4096), expected);
+    }
+}
+
+TEST(JsonStreamSerializer, Scalars)
+{
+    for (const nlohmann::json& json :
+         {nlohmann::json(), nlohmann::json(false), nlohmann::json(1.5),
+          nlohmann::json("str"), nlohmann::json::array(),
+          nlohmann::json::object()})
+    {
+        EXPECT_EQ(serialize(json, 2, 1), json.dump(2));
+    }
+}
+
+} // namespace
+} // namespace bmcweb
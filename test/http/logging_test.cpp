@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "logging.hpp"
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace crow
+{
+namespace
+{
+
+class LoggingTest : public ::testing::Test
+{
+  protected:
+    LoggingTest() : savedLevel(getBmcwebCurrentLoggingLevel()) {}
+
+    ~LoggingTest() override
+    {
+        getBmcwebCurrentLoggingLevel() = savedLevel;
+        LogFlusher::getInstance().setScheduler(nullptr);
+    }
+
+    LoggingTest(const LoggingTest&) = delete;
+    LoggingTest(LoggingTest&&) = delete;
+    LoggingTest& operator=(const LoggingTest&) = delete;
+    LoggingTest& operator=(LoggingTest&&) = delete;
+
+    LogLevel savedLevel;
+};
+
+TEST_F(LoggingTest, ArgumentsSkippedBelowLevel)
+{
+    int evaluated = 0;
+    auto expensive = [&evaluated]() {
+        evaluated++;
+        return std::string("value");
+    };
+
+    getBmcwebCurrentLoggingLevel() = LogLevel::Error;
+    BMCWEB_LOG_DEBUG("Debug {}", expensive());
+    BMCWEB_LOG_INFO("Info {}", expensive());
+    EXPECT_EQ(evaluated, 0);
+
+    BMCWEB_LOG_ERROR("Error {}", expensive());
+    EXPECT_EQ(evaluated, 1);
+}
+
+TEST_F(LoggingTest, FlushDeferredToScheduler)
+{
+    std::vector<std::function<void()>> scheduled;
+    LogFlusher::getInstance().setScheduler(
+        [&scheduled](std::function<void()>&& flush) {
+            scheduled.emplace_back(std::move(flush));
+        });
+
+    getBmcwebCurrentLoggingLevel() = LogLevel::Debug;
+    BMCWEB_LOG_DEBUG("First line");
+    BMCWEB_LOG_INFO("Second line");
+    // One flush covers every line logged before it runs
+    ASSERT_EQ(scheduled.size(), 1U);
+
+    scheduled[0]();
+    BMCWEB_LOG_DEBUG("Third line");
+    EXPECT_EQ(scheduled.size(), 2U);
+
+    // Errors are flushed straight away
+    BMCWEB_LOG_ERROR("Error line");
+    EXPECT_EQ(scheduled.size(), 2U);
+    scheduled[1]();
+}
+
+} // namespace
+} // namespace crow
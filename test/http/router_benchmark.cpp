@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "app.hpp"
+#include "benchmark.hpp"
+#include "http_request.hpp"
+#include "redfish.hpp"
+#include "routing.hpp"
+
+#include <boost/beast/http/verb.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+// Times Router::findRoute over a url for every registered Redfish route.  Run
+// with "meson test --benchmark router_benchmark".
+
+namespace
+{
+
+// Turns a route into a url that matches it
+std::string fillRoute(std::string_view route)
+{
+    std::string url;
+    while (!route.empty())
+    {
+        if (route.starts_with("<str>"))
+        {
+            url += "chassis0";
+            route.remove_prefix(5);
+        }
+        else if (route.starts_with("<path>"))
+        {
+            url += "a/b";
+            route.remove_prefix(6);
+        }
+        else
+        {
+            url += route.front();
+            route.remove_prefix(1);
+        }
+    }
+    return url;
+}
+
+} // namespace
+
+int main()
+{
+    crow::App app;
+    redfish::RedfishService redfish(app);
+    app.validate();
+
+    std::vector<std::unique_ptr<crow::Request>> requests;
+    for (const std::string* route : app.getRoutes())
+    {
+        std::error_code ec;
+        requests.emplace_back(std::make_unique<crow::Request>(
+            crow::Request::Body{boost::beast::http::verb::get,
+                                fillRoute(*route), 11},
+            ec));
+    }
+    if (requests.empty())
+    {
+        std::fputs("No routes registered\n", stderr);
+        return 1;
+    }
+
+    constexpr size_t iterations = 200;
+    size_t matched = 0;
+    using bmcweb::timePerIteration;
+    using std::chrono::nanoseconds;
+    // One iteration looks up every route once
+    double perSweep = timePerIteration<nanoseconds>(iterations, [&]() {
+        for (const std::unique_ptr<crow::Request>& req : requests)
+        {
+            crow::Router::FindRouteResponse found = app.router.findRoute(*req);
+            if (!found.allowHeader.empty())
+            {
+                matched++;
+            }
+        }
+    });
+
+    size_t lookups = iterations * requests.size();
+    std::printf("%zu routes, %zu lookups, %zu matched, %.1f ns per lookup\n",
+                requests.size(), lookups, matched,
+                perSweep / static_cast<double>(requests.size()));
+    return matched == lookups ? 0 : 1;
+}
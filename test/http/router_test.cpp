@@ -3,6 +3,7 @@
 #include "async_resp.hpp"
 #include "http_request.hpp"
 #include "routing.hpp"
+#include "static_routes.hpp"
 #include "utility.hpp"
 
 #include <boost/beast/http/verb.hpp>
@@ -94,6 +95,103 @@ TEST(Router, OverlapingRoutes)
     EXPECT_TRUE(barCalled);
 }
 
+TEST(Router, AllVerbsInOneWalk)
+{
+    auto nullCallback =
+        [](const Request&, const std::shared_ptr<bmcweb::AsyncResp>&) {};
+    auto paramCallback = [](const Request&,
+                            const std::shared_ptr<bmcweb::AsyncResp>&,
+                            const std::string&) {};
+
+    Router router;
+    std::error_code ec;
+
+    router.newRuleTagged<getParameterTag("/foo/<str>")>("/foo/<str>")
+        .methods(boost::beast::http::verb::get)(paramCallback);
+    router.newRuleTagged<getParameterTag("/foo/bar")>("/foo/bar")
+        .methods(boost::beast::http::verb::patch)(nullCallback);
+    router.newRuleTagged<getParameterTag("/foo/baz")>("/foo/baz")
+        .methods(boost::beast::http::verb::delete_)(nullCallback);
+    router.validate();
+
+    Request getReq{{boost::beast::http::verb::get, "/foo/bar", 11}, ec};
+    Router::FindRouteResponse found = router.findRoute(getReq);
+    EXPECT_EQ(found.allowHeader, "GET, PATCH");
+    ASSERT_NE(found.route.rule, nullptr);
+    EXPECT_EQ(found.route.rule->rule, "/foo/<str>");
+    ASSERT_EQ(found.route.params.size(), 1U);
+    EXPECT_EQ(found.route.params[0], "bar");
+
+    // Parameters point into the url of the request rather than a copy
+    std::string_view path = getReq.url().encoded_path();
+    EXPECT_EQ(found.route.params[0].data(), path.data() + 5);
+
+    Request patchReq{{boost::beast::http::verb::patch, "/foo/bar", 11}, ec};
+    found = router.findRoute(patchReq);
+    EXPECT_EQ(found.allowHeader, "GET, PATCH");
+    ASSERT_NE(found.route.rule, nullptr);
+    EXPECT_EQ(found.route.rule->rule, "/foo/bar");
+    EXPECT_TRUE(found.route.params.empty());
+
+    Request deleteReq{{boost::beast::http::verb::delete_, "/foo/bar", 11}, ec};
+    found = router.findRoute(deleteReq);
+    EXPECT_EQ(found.allowHeader, "GET, PATCH");
+    EXPECT_EQ(found.route.rule, nullptr);
+
+    Request bazReq{{boost::beast::http::verb::delete_, "/foo/baz", 11}, ec};
+    found = router.findRoute(bazReq);
+    EXPECT_EQ(found.allowHeader, "DELETE, GET");
+    ASSERT_NE(found.route.rule, nullptr);
+    EXPECT_EQ(found.route.rule->rule, "/foo/baz");
+}
+
+TEST(Router, StaticRouteTable)
+{
+    auto nullCallback =
+        [](const Request&, const std::shared_ptr<bmcweb::AsyncResp>&) {};
+    auto paramCallback = [](const Request&,
+                            const std::shared_ptr<bmcweb::AsyncResp>&,
+                            const std::string&) {};
+
+    // Both urls are registered by the Redfish tree, so they're in the
+    // generated table
+    ASSERT_TRUE(static_routes::find("/redfish/v1/").has_value());
+    ASSERT_TRUE(
+        static_routes::find("/redfish/v1/SessionService/").has_value());
+    EXPECT_FALSE(static_routes::find("/redfish/v1/NotARoute/").has_value());
+
+    Router router;
+    std::error_code ec;
+
+    router.newRuleTagged<getParameterTag("/redfish/v1/")>("/redfish/v1/")
+        .methods(boost::beast::http::verb::get)(nullCallback);
+    router.newRuleTagged<getParameterTag("/redfish/v1/<str>/")>(
+        "/redfish/v1/<str>/")
+        .methods(boost::beast::http::verb::get)(paramCallback);
+    router
+        .newRuleTagged<getParameterTag("/redfish/v1/SessionService/")>(
+            "/redfish/v1/SessionService/")
+        .methods(boost::beast::http::verb::patch)(nullCallback);
+    router.validate();
+
+    Request rootReq{{boost::beast::http::verb::get, "/redfish/v1", 11}, ec};
+    Router::FindRouteResponse found = router.findRoute(rootReq);
+    EXPECT_EQ(found.allowHeader, "GET");
+    ASSERT_NE(found.route.rule, nullptr);
+    EXPECT_EQ(found.route.rule->rule, "/redfish/v1/");
+
+    // The parameter route still wins for GET, as it does in the trie
+    Request getReq{
+        {boost::beast::http::verb::get, "/redfish/v1/SessionService/", 11},
+        ec};
+    found = router.findRoute(getReq);
+    EXPECT_EQ(found.allowHeader, "GET, PATCH");
+    ASSERT_NE(found.route.rule, nullptr);
+    EXPECT_EQ(found.route.rule->rule, "/redfish/v1/<str>/");
+    ASSERT_EQ(found.route.params.size(), 1U);
+    EXPECT_EQ(found.route.params[0], "SessionService");
+}
+
 TEST(Router, 404)
 {
     bool notFoundCalled = false;
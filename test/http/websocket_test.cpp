@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "http/websocket.hpp"
+#include "http/websocket_impl.hpp"
+#include "http_body.hpp"
+#include "http_request.hpp"
+#include "test_stream.hpp"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/verb.hpp>
+#include <boost/url/url.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+namespace crow
+{
+namespace websocket
+{
+
+namespace
+{
+
+struct Frame
+{
+    bool fin;
+    bool compressed;
+    uint8_t opcode;
+    std::string payload;
+};
+
+constexpr uint8_t textOpcode = 0x1;
+constexpr uint8_t binaryOpcode = 0x2;
+
+std::shared_ptr<ConnectionImpl<TestStream>> makeConnection(
+    TestStream&& stream, bool permessageDeflate, bool& closeCalled)
+{
+    boost::urls::url url("/ws");
+    return std::make_shared<ConnectionImpl<TestStream>>(
+        url, nullptr, std::move(stream), nullptr, nullptr, nullptr,
+        [&closeCalled](Connection&, const std::string&) {
+            closeCalled = true;
+        },
+        nullptr, permessageDeflate);
+}
+
+// Accepts the upgrade, and returns the handshake response the server sent
+std::string acceptUpgrade(boost::asio::io_context& io, TestStream& out,
+                          ConnectionImpl<TestStream>& conn)
+{
+    boost::beast::http::request<bmcweb::HttpBody> upgrade;
+    upgrade.method(boost::beast::http::verb::get);
+    upgrade.target("/ws");
+    upgrade.set(boost::beast::http::field::host, "openbmc_project.xyz");
+    upgrade.set(boost::beast::http::field::upgrade, "websocket");
+    upgrade.set(boost::beast::http::field::connection, "upgrade");
+    upgrade.set(boost::beast::http::field::sec_websocket_key,
+                "dGhlIHNhbXBsZSBub25jZQ==");
+    upgrade.set(boost::beast::http::field::sec_websocket_version, "13");
+    upgrade.set(boost::beast::http::field::sec_websocket_extensions,
+                "permessage-deflate");
+    std::error_code ec;
+    Request req(std::move(upgrade), ec);
+    EXPECT_FALSE(ec);
+
+    conn.start(req);
+    while (out.str().find("\r\n\r\n") == std::string::npos)
+    {
+        io.run_for(std::chrono::milliseconds(1));
+    }
+    std::string response;
+    response.resize(out.str().find("\r\n\r\n") + 4);
+    boost::asio::read(out, boost::asio::buffer(response));
+    return response;
+}
+
+// Reads count unmasked server frames with payloads under 126 bytes
+std::vector<Frame> readFrames(boost::asio::io_context& io, TestStream& out,
+                              size_t count)
+{
+    std::vector<Frame> frames;
+    while (frames.size() < count)
+    {
+        while (out.str().size() < 2 ||
+               out.str().size() <
+                   2 + static_cast<uint8_t>(out.str()[1] & 0x7f))
+        {
+            io.run_for(std::chrono::milliseconds(1));
+        }
+        std::string header(2, '\0');
+        boost::asio::read(out, boost::asio::buffer(header));
+        uint8_t first = static_cast<uint8_t>(header[0]);
+        uint8_t length = static_cast<uint8_t>(header[1]);
+        EXPECT_LT(length, 126);
+
+        Frame& frame = frames.emplace_back();
+        frame.fin = (first & 0x80) != 0;
+        frame.compressed = (first & 0x40) != 0;
+        frame.opcode = first & 0x0f;
+        frame.payload.resize(length);
+        boost::asio::read(out, boost::asio::buffer(frame.payload));
+    }
+    return frames;
+}
+
+TEST(WebSocket, QueuedMessagesKeepOrderAndType)
+{
+    boost::asio::io_context io;
+    TestStream stream(io);
+    TestStream out(io);
+    stream.connect(out);
+
+    bool closeCalled = false;
+    std::shared_ptr<ConnectionImpl<TestStream>> conn =
+        makeConnection(std::move(stream), false, closeCalled);
+    std::string response = acceptUpgrade(io, out, *conn);
+    EXPECT_TRUE(response.starts_with("HTTP/1.1 101"));
+    // Offered by the client, but not enabled on this route
+    EXPECT_EQ(response.find("permessage-deflate"), std::string::npos);
+
+    // Queued back to back, so all but the first wait on a write in progress
+    conn->sendText("one");
+    conn->sendBinary("two");
+    conn->sendText(std::make_shared<const std::string>("three"));
+    conn->sendBinary(std::make_shared<const std::string>("four"));
+
+    std::vector<Frame> frames = readFrames(io, out, 4);
+    ASSERT_EQ(frames.size(), 4);
+    EXPECT_EQ(frames[0].opcode, textOpcode);
+    EXPECT_EQ(frames[0].payload, "one");
+    EXPECT_EQ(frames[1].opcode, binaryOpcode);
+    EXPECT_EQ(frames[1].payload, "two");
+    EXPECT_EQ(frames[2].opcode, textOpcode);
+    EXPECT_EQ(frames[2].payload, "three");
+    EXPECT_EQ(frames[3].opcode, binaryOpcode);
+    EXPECT_EQ(frames[3].payload, "four");
+    for (const Frame& frame : frames)
+    {
+        EXPECT_TRUE(frame.fin);
+        EXPECT_FALSE(frame.compressed);
+    }
+    EXPECT_TRUE(out.str().empty());
+
+    out.close();
+    while (!closeCalled)
+    {
+        io.run_for(std::chrono::milliseconds(1));
+    }
+}
+
+TEST(WebSocket, PermessageDeflate)
+{
+    boost::asio::io_context io;
+    TestStream stream(io);
+    TestStream out(io);
+    stream.connect(out);
+
+    bool closeCalled = false;
+    std::shared_ptr<ConnectionImpl<TestStream>> conn =
+        makeConnection(std::move(stream), true, closeCalled);
+    std::string response = acceptUpgrade(io, out, *conn);
+    EXPECT_TRUE(response.starts_with("HTTP/1.1 101"));
+    EXPECT_NE(response.find("permessage-deflate"), std::string::npos);
+
+    // Under the size threshold, so sent as is
+    conn->sendText("ls\n");
+    std::string longText(200, 'a');
+    conn->sendText(longText);
+
+    std::vector<Frame> frames = readFrames(io, out, 2);
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(frames[0].opcode, textOpcode);
+    EXPECT_FALSE(frames[0].compressed);
+    EXPECT_EQ(frames[0].payload, "ls\n");
+
+    EXPECT_EQ(frames[1].opcode, textOpcode);
+    EXPECT_TRUE(frames[1].fin);
+    EXPECT_TRUE(frames[1].compressed);
+    EXPECT_LT(frames[1].payload.size(), longText.size());
+    EXPECT_TRUE(out.str().empty());
+
+    out.close();
+    while (!closeCalled)
+    {
+        io.run_for(std::chrono::milliseconds(1));
+    }
+}
+
+} // namespace
+} // namespace websocket
+} // namespace crow
@@ -2,7 +2,12 @@
 // SPDX-FileCopyrightText: Copyright OpenBMC Authors
 #include "async_resolve.hpp"
 
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/address.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -25,3 +30,23 @@ TEST(AsyncResolve, ipv6Positive)
     EXPECT_TRUE(ep.address().is_v6());
     EXPECT_EQ(ep.address().to_string(), "102:304:506:708:90a:b0c:d0e:f10");
 }
+
+TEST(AsyncResolve, addressNeedsNoLookup)
+{
+    boost::asio::io_context io;
+    async_resolve::Resolver resolver(io);
+    std::vector<boost::asio::ip::tcp::endpoint> endpoints;
+    resolver.async_resolve(
+        "127.0.0.1", "443",
+        [&endpoints](const boost::system::error_code& ec,
+                     const async_resolve::Resolver::results_type& results) {
+            EXPECT_FALSE(ec);
+            endpoints = results;
+        });
+    io.run();
+
+    ASSERT_EQ(endpoints.size(), 1);
+    EXPECT_EQ(endpoints[0].address(),
+              boost::asio::ip::make_address("127.0.0.1"));
+    EXPECT_EQ(endpoints[0].port(), 443);
+}
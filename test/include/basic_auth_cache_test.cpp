@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "basic_auth_cache.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace crow
+{
+namespace
+{
+
+TEST(BasicAuthCache, VerifiesOnlyCachedPassword)
+{
+    BasicAuthCache cache;
+    EXPECT_FALSE(cache.verify("admin", "0penBmc"));
+
+    cache.insert("admin", "0penBmc");
+    EXPECT_TRUE(cache.verify("admin", "0penBmc"));
+    EXPECT_FALSE(cache.verify("admin", "0penBmc0"));
+    EXPECT_FALSE(cache.verify("admin", ""));
+    EXPECT_FALSE(cache.verify("operator", "0penBmc"));
+}
+
+TEST(BasicAuthCache, InvalidateRemovesEntry)
+{
+    BasicAuthCache cache;
+    cache.insert("admin", "0penBmc");
+    cache.insert("operator", "0penBmc");
+
+    cache.invalidate("admin");
+    EXPECT_FALSE(cache.verify("admin", "0penBmc"));
+    EXPECT_TRUE(cache.verify("operator", "0penBmc"));
+
+    cache.clear();
+    EXPECT_FALSE(cache.verify("operator", "0penBmc"));
+}
+
+TEST(BasicAuthCache, EntriesExpire)
+{
+    BasicAuthCache cache(std::chrono::seconds(0));
+    cache.insert("admin", "0penBmc");
+    EXPECT_FALSE(cache.verify("admin", "0penBmc"));
+}
+
+TEST(BasicAuthCache, BoundedSize)
+{
+    BasicAuthCache cache;
+    for (size_t i = 0; i <= BasicAuthCache::maxEntries; i++)
+    {
+        cache.insert("user" + std::to_string(i), "0penBmc");
+    }
+    std::string last = "user" + std::to_string(BasicAuthCache::maxEntries);
+    EXPECT_TRUE(cache.verify(last, "0penBmc"));
+    EXPECT_FALSE(cache.verify("user0", "0penBmc"));
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "dbus_call_coalescer.hpp"
+
+#include <boost/system/errc.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace dbus::utility
+{
+namespace
+{
+
+using Coalescer = DbusCallCoalescer<std::string>;
+
+const Coalescer::Key key("xyz.openbmc_project.Test", "/xyz/openbmc_project");
+
+TEST(DbusCallCoalescer, SameGenerationSharesCall)
+{
+    Coalescer calls;
+    std::vector<std::string> replies;
+    auto record = [&replies](const boost::system::error_code&,
+                             const std::string& reply) {
+        replies.push_back(reply);
+    };
+
+    std::shared_ptr<Coalescer::Call> call = calls.join(key, 1, record);
+    ASSERT_NE(call, nullptr);
+    EXPECT_EQ(calls.join(key, 1, record), nullptr);
+    EXPECT_EQ(calls.size(), 1U);
+
+    calls.complete(key, call, {}, "objects");
+    EXPECT_EQ(replies, (std::vector<std::string>{"objects", "objects"}));
+    EXPECT_EQ(calls.size(), 0U);
+
+    // Nothing is in flight any more, so the next caller sends a new call
+    EXPECT_NE(calls.join(key, 1, record), nullptr);
+}
+
+TEST(DbusCallCoalescer, ChangeSignalledAfterSendStartsNewCall)
+{
+    Coalescer calls;
+    std::vector<std::string> oldReplies;
+    std::vector<std::string> newReplies;
+
+    std::shared_ptr<Coalescer::Call> oldCall = calls.join(
+        key, 1, [&oldReplies](const boost::system::error_code&,
+                              const std::string& reply) {
+            oldReplies.push_back(reply);
+        });
+    ASSERT_NE(oldCall, nullptr);
+
+    // The service signalled a change while the first call was in flight.
+    // The reply to that call may predate the change, so it isn't shared.
+    std::shared_ptr<Coalescer::Call> newCall = calls.join(
+        key, 2, [&newReplies](const boost::system::error_code&,
+                              const std::string& reply) {
+            newReplies.push_back(reply);
+        });
+    ASSERT_NE(newCall, nullptr);
+
+    calls.complete(key, oldCall, {}, "before");
+    EXPECT_EQ(oldReplies, std::vector<std::string>{"before"});
+    EXPECT_TRUE(newReplies.empty());
+    // The newer call is still in flight and still takes new callers
+    EXPECT_EQ(calls.size(), 1U);
+
+    calls.complete(key, newCall, {}, "after");
+    EXPECT_EQ(newReplies, std::vector<std::string>{"after"});
+    EXPECT_EQ(calls.size(), 0U);
+}
+
+TEST(DbusCallCoalescer, ErrorReachesEveryCaller)
+{
+    Coalescer calls;
+    size_t errors = 0;
+    auto record = [&errors](const boost::system::error_code& ec,
+                            const std::string&) {
+        if (ec)
+        {
+            errors++;
+        }
+    };
+    std::shared_ptr<Coalescer::Call> call = calls.join(key, 0, record);
+    ASSERT_NE(call, nullptr);
+    EXPECT_EQ(calls.join(key, 0, record), nullptr);
+
+    calls.complete(key, call,
+                   boost::system::errc::make_error_code(
+                       boost::system::errc::timed_out),
+                   "");
+    EXPECT_EQ(errors, 2U);
+}
+
+} // namespace
+} // namespace dbus::utility
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "dbus_object_cache.hpp"
+#include "dbus_utility.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace dbus::utility
+{
+namespace
+{
+
+const std::string service = "xyz.openbmc_project.Test";
+const std::string path = "/xyz/openbmc_project/test";
+const std::string iface = "xyz.openbmc_project.Test.Value";
+
+DBusPropertiesMap makeProperties(double value)
+{
+    DBusPropertiesMap properties;
+    properties.emplace_back("Value", value);
+    properties.emplace_back("Unit", std::string("Degrees"));
+    return properties;
+}
+
+TEST(DbusObjectCache, MissThenHit)
+{
+    DbusObjectCache cache;
+    EXPECT_EQ(cache.findProperties(service, path, iface), nullptr);
+
+    uint64_t generation = cache.getGeneration(service);
+    cache.insertProperties(service, path, iface, makeProperties(1.0),
+                           generation);
+    std::shared_ptr<const DBusPropertiesMap> cached =
+        cache.findProperties(service, path, iface);
+    ASSERT_NE(cached, nullptr);
+    EXPECT_EQ(*cached, makeProperties(1.0));
+    EXPECT_EQ(cache.size(), 2U);
+
+    EXPECT_EQ(cache.findProperties(service, path, "other.Interface"),
+              nullptr);
+    EXPECT_EQ(cache.getHits(), 1U);
+    EXPECT_EQ(cache.getMisses(), 2U);
+}
+
+TEST(DbusObjectCache, InvalidateService)
+{
+    DbusObjectCache cache;
+    uint64_t generation = cache.getGeneration(service);
+    cache.insertProperties(service, path, iface, makeProperties(1.0),
+                           generation);
+    uint64_t otherGeneration = cache.getGeneration("other.Service");
+    cache.insertProperties("other.Service", path, iface, makeProperties(2.0),
+                           otherGeneration);
+
+    cache.invalidateService(service);
+    EXPECT_EQ(cache.findProperties(service, path, iface), nullptr);
+    EXPECT_NE(cache.findProperties("other.Service", path, iface), nullptr);
+    EXPECT_EQ(cache.size(), 2U);
+}
+
+TEST(DbusObjectCache, StaleReplyNotCached)
+{
+    DbusObjectCache cache;
+    uint64_t generation = cache.getGeneration(service);
+    // A change signal arrives while the call is in flight
+    cache.invalidateService(service);
+    cache.insertProperties(service, path, iface, makeProperties(1.0),
+                           generation);
+    EXPECT_EQ(cache.findProperties(service, path, iface), nullptr);
+}
+
+TEST(DbusObjectCache, ManagedObjects)
+{
+    DbusObjectCache cache;
+    ManagedObjectType objects;
+    objects.emplace_back(sdbusplus::message::object_path(path),
+                         DBusInterfacesMap{{iface, makeProperties(3.0)}});
+
+    uint64_t generation = cache.getGeneration(service);
+    cache.insertManagedObjects(service, "/", objects, generation);
+    std::shared_ptr<const ManagedObjectType> cached =
+        cache.findManagedObjects(service, "/");
+    ASSERT_NE(cached, nullptr);
+    EXPECT_EQ(cached->size(), 1U);
+    EXPECT_EQ(cache.size(), 2U);
+
+    cache.invalidateService(service);
+    EXPECT_EQ(cache.findManagedObjects(service, "/"), nullptr);
+    EXPECT_EQ(cache.size(), 0U);
+}
+
+TEST(DbusObjectCache, ClearsWhenFull)
+{
+    DbusObjectCache cache;
+    uint64_t generation = cache.getGeneration(service);
+    for (size_t i = 0; i <= DbusObjectCache::maxProperties / 2; i++)
+    {
+        cache.insertProperties(service, path + std::to_string(i), iface,
+                               makeProperties(1.0), generation);
+        generation = cache.getGeneration(service);
+    }
+    EXPECT_LE(cache.size(), DbusObjectCache::maxProperties);
+    EXPECT_EQ(cache.findProperties(service, path + "0", iface), nullptr);
+}
+
+} // namespace
+} // namespace dbus::utility
@@ -5,7 +5,11 @@
 
 #include <boost/beast/http/fields.hpp>
 
+#include <cstddef>
+#include <functional>
 #include <iterator>
+#include <map>
+#include <string>
 #include <string_view>
 #include <system_error>
 #include <vector>
@@ -449,4 +453,89 @@ TEST_F(MultipartTest, TestFinalBoundaryIsCorrectlyRecognized)
               "StillData1");
 }
 
+TEST_F(MultipartTest, TestSplitAnywhere)
+{
+    std::string_view body =
+        "-----------------------------d74496d66958873e\r\n"
+        "Content-Disposition: form-data; name=\"Test1\"\r\n\r\n"
+        "111111111111111111111111112222222222222222222222222222222\r\n"
+        "-----------------------------d74496d66958873e\r\n"
+        "Content-Disposition: form-data; name=\"Test2\"\r\n\r\n"
+        "{\r\n-----------------------------d74496d66958873e123456\r\n"
+        "-----------------------------d74496d66958873e--\r\n";
+    std::string_view contentType =
+        "multipart/form-data; "
+        "boundary=---------------------------d74496d66958873e";
+
+    for (size_t split = 0; split <= body.size(); split++)
+    {
+        MultipartParser splitParser;
+        ASSERT_EQ(splitParser.start(contentType), ParserError::PARSER_SUCCESS);
+        ASSERT_EQ(splitParser.feed(body.substr(0, split)),
+                  ParserError::PARSER_SUCCESS);
+        ASSERT_EQ(splitParser.feed(body.substr(split)),
+                  ParserError::PARSER_SUCCESS);
+        ASSERT_EQ(splitParser.finish(), ParserError::PARSER_SUCCESS);
+
+        ASSERT_EQ(splitParser.mime_fields.size(), 2);
+        EXPECT_EQ(splitParser.mime_fields[0].fields.at("Content-Disposition"),
+                  "form-data; name=\"Test1\"");
+        EXPECT_EQ(
+            splitParser.mime_fields[0].content,
+            "111111111111111111111111112222222222222222222222222222222");
+        EXPECT_EQ(splitParser.mime_fields[1].fields.at("Content-Disposition"),
+                  "form-data; name=\"Test2\"");
+        EXPECT_EQ(splitParser.mime_fields[1].content,
+                  "{\r\n-----------------------------d74496d66958873e123456");
+    }
+}
+
+TEST_F(MultipartTest, TestByteAtATimeWithCallback)
+{
+    std::string_view body =
+        "----XX\r\n"
+        "Content-Disposition: form-data; name=\"Test1\"\r\n\r\n"
+        "Data1\r\n"
+        "----XX-abc-\r\n"
+        "StillData1\r\n"
+        "----XX\r\n"
+        "Content-Disposition: form-data; name=\"Test2\"\r\n\r\n"
+        "Data2\r\n"
+        "----XX--\r\n";
+
+    std::map<std::string, std::string, std::less<>> received;
+    parser.onPartData = [&received](FormPart& part, std::string_view data) {
+        received[std::string(part.fields.at("Content-Disposition"))] += data;
+    };
+
+    ASSERT_EQ(parser.start("multipart/form-data; boundary=--XX"),
+              ParserError::PARSER_SUCCESS);
+    for (char c : body)
+    {
+        ASSERT_EQ(parser.feed(std::string_view(&c, 1)),
+                  ParserError::PARSER_SUCCESS);
+    }
+    ASSERT_EQ(parser.finish(), ParserError::PARSER_SUCCESS);
+
+    ASSERT_EQ(parser.mime_fields.size(), 2);
+    // Data handed to the callback isn't copied into the parser
+    EXPECT_TRUE(parser.mime_fields[0].content.empty());
+    EXPECT_TRUE(parser.mime_fields[1].content.empty());
+    ASSERT_EQ(received.size(), 2);
+    EXPECT_EQ(received["form-data; name=\"Test1\""],
+              "Data1\r\n----XX-abc-\r\nStillData1");
+    EXPECT_EQ(received["form-data; name=\"Test2\""], "Data2");
+}
+
+TEST_F(MultipartTest, TestFinishBeforeEnd)
+{
+    ASSERT_EQ(parser.start("multipart/form-data; boundary=--XX"),
+              ParserError::PARSER_SUCCESS);
+    ASSERT_EQ(parser.feed("----XX\r\n"
+                          "Content-Disposition: form-data; name=\"T\"\r\n\r\n"
+                          "Data"),
+              ParserError::PARSER_SUCCESS);
+    EXPECT_EQ(parser.finish(), ParserError::ERROR_UNEXPECTED_END_OF_INPUT);
+}
+
 } // namespace
@@ -0,0 +1,163 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "dbus_utility.hpp"
+#include "object_mapper_mirror.hpp"
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace dbus::utility
+{
+namespace
+{
+
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+constexpr std::array<std::string_view, 1> chassisInterfaces = {
+    "xyz.openbmc_project.Inventory.Item.Chassis"};
+constexpr std::array<std::string_view, 1> fanInterfaces = {
+    "xyz.openbmc_project.Inventory.Item.Fan"};
+constexpr std::array<std::string_view, 0> noInterfaces = {};
+
+ObjectMapperMirror makeMirror()
+{
+    ObjectMapperMirror mirror;
+    MapperGetSubTreeResponse tree{
+        {"/xyz", {}},
+        {"/xyz/inventory", {}},
+        {"/xyz/inventory/chassis",
+         {{"xyz.openbmc_project.EntityManager",
+           {"xyz.openbmc_project.Inventory.Item.Chassis"}},
+          {"xyz.openbmc_project.Other", {"xyz.openbmc_project.Other"}}}},
+        {"/xyz/inventory/chassis/fan0",
+         {{"xyz.openbmc_project.EntityManager",
+           {"xyz.openbmc_project.Inventory.Item.Fan"}}}},
+        {"/xyz/inventory/chassis/fan1",
+         {{"xyz.openbmc_project.EntityManager",
+           {"xyz.openbmc_project.Inventory.Item.Fan"}}}},
+        {"/xyz/inventory2",
+         {{"xyz.openbmc_project.EntityManager",
+           {"xyz.openbmc_project.Inventory.Item.Chassis"}}}},
+    };
+    mirror.replaceTree(tree, mirror.markStale());
+    return mirror;
+}
+
+TEST(ObjectMapperMirror, StaleUntilLoaded)
+{
+    ObjectMapperMirror mirror;
+    EXPECT_FALSE(mirror.isCurrent());
+    uint64_t token = mirror.markStale();
+    mirror.replaceTree({}, token);
+    EXPECT_TRUE(mirror.isCurrent());
+
+    // A second resync requested while the first one is in flight
+    token = mirror.markStale();
+    uint64_t newer = mirror.markStale();
+    mirror.replaceTree({}, token);
+    EXPECT_FALSE(mirror.isCurrent());
+    mirror.replaceTree({}, newer);
+    EXPECT_TRUE(mirror.isCurrent());
+
+    mirror.beginUpdate();
+    EXPECT_FALSE(mirror.isCurrent());
+    mirror.endUpdate();
+    EXPECT_TRUE(mirror.isCurrent());
+}
+
+TEST(ObjectMapperMirror, SubTree)
+{
+    ObjectMapperMirror mirror = makeMirror();
+
+    std::optional<MapperGetSubTreeResponse> subtree =
+        mirror.getSubTree("/xyz/inventory", 0, chassisInterfaces);
+    ASSERT_TRUE(subtree);
+    // Only the matching service is returned, and /xyz/inventory2 is not a
+    // child of /xyz/inventory
+    EXPECT_THAT(*subtree,
+                ElementsAre(Pair("/xyz/inventory/chassis",
+                                 ElementsAre(Pair(
+                                     "xyz.openbmc_project.EntityManager",
+                                     ElementsAre(chassisInterfaces[0]))))));
+
+    subtree = mirror.getSubTree("/xyz/inventory/", 1, noInterfaces);
+    ASSERT_TRUE(subtree);
+    ASSERT_EQ(subtree->size(), 1U);
+    EXPECT_EQ((*subtree)[0].second.size(), 2U);
+
+    subtree = mirror.getSubTree("/", 0, fanInterfaces);
+    ASSERT_TRUE(subtree);
+    EXPECT_EQ(subtree->size(), 2U);
+
+    // Unknown paths are left for the mapper to report
+    EXPECT_FALSE(mirror.getSubTree("/xyz/missing", 0, noInterfaces));
+}
+
+TEST(ObjectMapperMirror, UpdateObjects)
+{
+    ObjectMapperMirror mirror = makeMirror();
+    mirror.removeObject("/xyz/inventory/chassis/fan1");
+    mirror.setObject("/xyz/inventory/chassis/fan2",
+                     {{"xyz.openbmc_project.EntityManager",
+                       {"xyz.openbmc_project.Inventory.Item.Fan"}}});
+
+    std::optional<MapperGetSubTreeResponse> subtree =
+        mirror.getSubTree("/xyz/inventory", 0, fanInterfaces);
+    ASSERT_TRUE(subtree);
+    EXPECT_THAT(*subtree, ElementsAre(Pair("/xyz/inventory/chassis/fan0", _),
+                                      Pair("/xyz/inventory/chassis/fan2", _)));
+}
+
+TEST(ObjectMapperMirror, AssociatedSubTree)
+{
+    ObjectMapperMirror mirror = makeMirror();
+    const std::string association = "/xyz/inventory/chassis/cooled_by";
+
+    EXPECT_FALSE(mirror.getAssociatedSubTree(association, "/xyz/inventory", 0,
+                                             fanInterfaces));
+
+    mirror.setEndPoints(association, {"/xyz/inventory/chassis/fan1"});
+    std::optional<MapperGetSubTreeResponse> subtree =
+        mirror.getAssociatedSubTree(association, "/xyz/inventory", 0,
+                                    fanInterfaces);
+    ASSERT_TRUE(subtree);
+    EXPECT_THAT(*subtree,
+                ElementsAre(Pair("/xyz/inventory/chassis/fan1", _)));
+
+    mirror.eraseEndPoints(association);
+    EXPECT_EQ(mirror.getEndPoints(association), nullptr);
+}
+
+TEST(ObjectMapperMirror, AssociatedSubTreeById)
+{
+    ObjectMapperMirror mirror = makeMirror();
+
+    std::vector<std::string> missing;
+    EXPECT_FALSE(mirror.getAssociatedSubTreeById(
+        "chassis", "/xyz/inventory", chassisInterfaces, "cooled_by",
+        fanInterfaces, missing));
+    EXPECT_THAT(missing, ElementsAre("/xyz/inventory/chassis/cooled_by"));
+
+    mirror.setEndPoints("/xyz/inventory/chassis/cooled_by",
+                        {"/xyz/inventory/chassis/fan0"});
+    missing.clear();
+    std::optional<MapperGetSubTreeResponse> subtree =
+        mirror.getAssociatedSubTreeById("chassis", "/xyz/inventory",
+                                        chassisInterfaces, "cooled_by",
+                                        fanInterfaces, missing);
+    ASSERT_TRUE(subtree);
+    EXPECT_TRUE(missing.empty());
+    EXPECT_THAT(*subtree,
+                ElementsAre(Pair("/xyz/inventory/chassis/fan0", _)));
+}
+
+} // namespace
+} // namespace dbus::utility
@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "file_test_utilities.hpp"
+#include "persistent_data.hpp"
+#include "sessions.hpp"
+
+#include <boost/asio/ip/address.hpp>
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace persistent_data
+{
+namespace
+{
+
+// ConfigFile reads and writes the current directory, so each test runs in a
+// directory of its own
+class PersistentDataTest : public ::testing::Test
+{
+  protected:
+    PersistentDataTest() : oldCwd(std::filesystem::current_path())
+    {
+        std::filesystem::current_path(dir.path);
+    }
+
+    PersistentDataTest(const PersistentDataTest&) = delete;
+    PersistentDataTest(PersistentDataTest&&) = delete;
+    PersistentDataTest& operator=(const PersistentDataTest&) = delete;
+    PersistentDataTest& operator=(PersistentDataTest&&) = delete;
+
+    ~PersistentDataTest() override
+    {
+        SessionStore& store = SessionStore::getInstance();
+        std::vector<std::shared_ptr<UserSession>> sessions;
+        for (const auto& p : store.authTokens)
+        {
+            sessions.push_back(p.second);
+        }
+        for (const std::shared_ptr<UserSession>& session : sessions)
+        {
+            store.removeSession(session);
+        }
+        std::filesystem::current_path(oldCwd);
+    }
+
+    static nlohmann::json::object_t makeSession(const std::string& name)
+    {
+        nlohmann::json::object_t session;
+        session["unique_id"] = name + "_id";
+        session["session_token"] = name + "_token";
+        session["username"] = name;
+        session["csrf_token"] = name + "_csrf";
+        session["client_ip"] = "127.0.0.1";
+        return session;
+    }
+
+    static void writeSnapshot(const nlohmann::json::array_t& sessions)
+    {
+        nlohmann::json::object_t data;
+        data["revision"] = 1;
+        data["system_uuid"] = "c6a3ef3b-0a8e-4bf8-9a5f-0e0e1c0a7d11";
+        data["sessions"] = sessions;
+        std::ofstream file(ConfigFile::filename);
+        file << nlohmann::json(data).dump();
+    }
+
+    static size_t countJournalLines()
+    {
+        std::ifstream file(ConfigFile::journalFilename);
+        size_t lines = 0;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            lines++;
+        }
+        return lines;
+    }
+
+    static size_t countSnapshotSessions()
+    {
+        std::ifstream file(ConfigFile::filename);
+        nlohmann::json data = nlohmann::json::parse(file, nullptr, false);
+        if (!data.contains("sessions"))
+        {
+            return 0;
+        }
+        return data["sessions"].size();
+    }
+
+    static bool hasSession(const std::string& name)
+    {
+        return SessionStore::getInstance().authTokens.contains(name + "_token");
+    }
+
+    std::filesystem::path oldCwd;
+    TemporaryDirectory dir{"bmcweb_persistent_data_test"};
+};
+
+TEST_F(PersistentDataTest, ReplaysJournalOverSnapshot)
+{
+    writeSnapshot({makeSession("a"), makeSession("b")});
+    {
+        std::ofstream journal(ConfigFile::journalFilename);
+        nlohmann::json::object_t add;
+        add["add"] = makeSession("c");
+        journal << nlohmann::json(add).dump() << '\n';
+        nlohmann::json::object_t remove;
+        remove["remove"] = "a_token";
+        journal << nlohmann::json(remove).dump() << '\n';
+    }
+
+    ConfigFile config;
+    EXPECT_FALSE(hasSession("a"));
+    EXPECT_TRUE(hasSession("b"));
+    EXPECT_TRUE(hasSession("c"));
+
+    // The journal is folded into the snapshot on startup
+    EXPECT_FALSE(std::filesystem::exists(ConfigFile::journalFilename));
+    EXPECT_EQ(countSnapshotSessions(), 2);
+}
+
+TEST_F(PersistentDataTest, IgnoresTornLastJournalEntry)
+{
+    writeSnapshot({makeSession("a")});
+    {
+        std::ofstream journal(ConfigFile::journalFilename);
+        nlohmann::json::object_t add;
+        add["add"] = makeSession("b");
+        journal << nlohmann::json(add).dump() << '\n';
+        // Cut short by a power loss, without the trailing newline
+        add["add"] = makeSession("c");
+        std::string torn = nlohmann::json(add).dump();
+        journal << torn.substr(0, torn.size() / 2);
+    }
+
+    ConfigFile config;
+    EXPECT_TRUE(hasSession("a"));
+    EXPECT_TRUE(hasSession("b"));
+    EXPECT_FALSE(hasSession("c"));
+    EXPECT_EQ(countSnapshotSessions(), 2);
+}
+
+TEST_F(PersistentDataTest, CompactsJournalAtMaxEntries)
+{
+    ConfigFile config;
+    SessionStore& store = SessionStore::getInstance();
+    boost::asio::ip::address ip = boost::asio::ip::make_address("127.0.0.1");
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        ASSERT_NE(store.generateUserSession("user", ip, std::nullopt,
+                                            SessionType::Session),
+                  nullptr);
+    }
+    // Basic sessions are never journaled
+    ASSERT_NE(store.generateUserSession("user", ip, std::nullopt,
+                                        SessionType::Basic),
+              nullptr);
+    config.flushPendingWrite();
+    EXPECT_EQ(countJournalLines(), 3);
+    EXPECT_EQ(countSnapshotSessions(), 0);
+
+    for (size_t i = 0; i < ConfigFile::maxJournalEntries; i++)
+    {
+        ASSERT_NE(store.generateUserSession("user", ip, std::nullopt,
+                                            SessionType::Session),
+                  nullptr);
+    }
+    config.flushPendingWrite();
+    EXPECT_FALSE(std::filesystem::exists(ConfigFile::journalFilename));
+    EXPECT_EQ(countSnapshotSessions(), ConfigFile::maxJournalEntries + 3);
+}
+
+} // namespace
+} // namespace persistent_data
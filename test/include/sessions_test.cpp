@@ -1,7 +1,13 @@
 #include "sessions.hpp"
 
+#include <boost/asio/ip/address.hpp>
 #include <nlohmann/json.hpp>
 
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 namespace
@@ -42,4 +48,89 @@ TEST(AuthConfigMethods, FromJsonMTLSCommonNameParseModeOutOfRange)
     EXPECT_EQ(methods.xtoken, true);
     EXPECT_EQ(methods.mTLSCommonNameParsingMode, prevValue);
 }
+
+TEST(SessionStore, OnChangeSeparatesSessionAndConfigChanges)
+{
+    persistent_data::SessionStore& store =
+        persistent_data::SessionStore::getInstance();
+    std::vector<bool> changes;
+    store.onChange = [&changes](bool fullWrite) {
+        changes.push_back(fullWrite);
+    };
+
+    boost::asio::ip::address ip = boost::asio::ip::make_address("127.0.0.1");
+    std::shared_ptr<persistent_data::UserSession> basic =
+        store.generateUserSession("user", ip, std::nullopt,
+                                  persistent_data::SessionType::Basic);
+    ASSERT_NE(basic, nullptr);
+    // Basic sessions are never written
+    EXPECT_TRUE(changes.empty());
+    store.removeSession(basic);
+    EXPECT_TRUE(changes.empty());
+
+    std::shared_ptr<persistent_data::UserSession> session =
+        store.generateUserSession("user", ip, std::nullopt,
+                                  persistent_data::SessionType::Session);
+    ASSERT_NE(session, nullptr);
+    store.removeSession(session);
+    store.updateSessionTimeout(std::chrono::seconds(1800));
+    EXPECT_EQ(changes, std::vector<bool>({false, false, true}));
+
+    store.onChange = nullptr;
+}
+
+TEST(SessionStore, IndexesFollowSessions)
+{
+    persistent_data::SessionStore& store =
+        persistent_data::SessionStore::getInstance();
+    boost::asio::ip::address ip = boost::asio::ip::make_address("127.0.0.1");
+
+    std::shared_ptr<persistent_data::UserSession> first =
+        store.generateUserSession("indexuser", ip, std::nullopt,
+                                  persistent_data::SessionType::Session);
+    std::shared_ptr<persistent_data::UserSession> second =
+        store.generateUserSession("indexuser", ip, std::nullopt,
+                                  persistent_data::SessionType::Session);
+    std::shared_ptr<persistent_data::UserSession> basic =
+        store.generateUserSession("indexuser", ip, std::nullopt,
+                                  persistent_data::SessionType::Basic);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    ASSERT_NE(basic, nullptr);
+
+    EXPECT_EQ(store.getSessionByUid(first->uniqueId), first);
+    EXPECT_EQ(store.getBasicSession("indexuser", "127.0.0.1"), basic);
+    EXPECT_EQ(store.getBasicSession("indexuser", "127.0.0.2"), nullptr);
+    EXPECT_EQ(store.getBasicSession("otheruser", "127.0.0.1"), nullptr);
+
+    store.removeSessionsByUsernameExceptSession("indexuser", second);
+    EXPECT_EQ(store.getSessionByUid(first->uniqueId), nullptr);
+    EXPECT_EQ(store.getSessionByUid(basic->uniqueId), nullptr);
+    EXPECT_EQ(store.getBasicSession("indexuser", "127.0.0.1"), nullptr);
+    EXPECT_EQ(store.getSessionByUid(second->uniqueId), second);
+
+    store.removeSessionsByUsername("indexuser");
+    EXPECT_EQ(store.getSessionByUid(second->uniqueId), nullptr);
+    EXPECT_EQ(store.loginSessionByToken(second->sessionToken), nullptr);
+}
+
+TEST(SessionStore, ExpiresIdleSessions)
+{
+    persistent_data::SessionStore& store =
+        persistent_data::SessionStore::getInstance();
+    boost::asio::ip::address ip = boost::asio::ip::make_address("127.0.0.1");
+
+    std::shared_ptr<persistent_data::UserSession> session =
+        store.generateUserSession("expiryuser", ip, std::nullopt,
+                                  persistent_data::SessionType::Session);
+    ASSERT_NE(session, nullptr);
+    EXPECT_EQ(store.loginSessionByToken(session->sessionToken), session);
+
+    // Shortening the timeout applies to sessions that already exist
+    store.updateSessionTimeout(std::chrono::seconds(0));
+    EXPECT_EQ(store.loginSessionByToken(session->sessionToken), nullptr);
+    EXPECT_EQ(store.getSessionByUid(session->uniqueId), nullptr);
+
+    store.updateSessionTimeout(std::chrono::seconds(1800));
+}
 } // namespace
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "dbus_utility.hpp"
+#include "user_info_cache.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace crow
+{
+namespace
+{
+
+dbus::utility::DBusPropertiesMap makeUserInfo(const std::string& role)
+{
+    dbus::utility::DBusPropertiesMap userInfo;
+    userInfo.emplace_back("UserPrivilege", role);
+    userInfo.emplace_back("RemoteUser", false);
+    userInfo.emplace_back("UserPasswordExpired", false);
+    return userInfo;
+}
+
+TEST(UserInfoCache, MissThenHit)
+{
+    UserInfoCache cache;
+    EXPECT_EQ(cache.find("admin"), nullptr);
+
+    cache.insert("admin", makeUserInfo("priv-admin"), cache.getGeneration());
+    const dbus::utility::DBusPropertiesMap* userInfo = cache.find("admin");
+    ASSERT_NE(userInfo, nullptr);
+    EXPECT_EQ(*userInfo, makeUserInfo("priv-admin"));
+
+    EXPECT_EQ(cache.getHits(), 1U);
+    EXPECT_EQ(cache.getMisses(), 1U);
+    EXPECT_DOUBLE_EQ(cache.getHitRatio(), 0.5);
+}
+
+TEST(UserInfoCache, InvalidateRemovesEntry)
+{
+    UserInfoCache cache;
+    cache.insert("admin", makeUserInfo("priv-admin"), cache.getGeneration());
+    cache.insert("operator", makeUserInfo("priv-operator"),
+                 cache.getGeneration());
+
+    cache.invalidate("admin");
+    EXPECT_EQ(cache.find("admin"), nullptr);
+    EXPECT_NE(cache.find("operator"), nullptr);
+
+    cache.clear();
+    EXPECT_EQ(cache.find("operator"), nullptr);
+}
+
+TEST(UserInfoCache, StaleGenerationIsNotCached)
+{
+    UserInfoCache cache;
+    uint64_t generation = cache.getGeneration();
+    cache.invalidate("admin");
+    cache.insert("admin", makeUserInfo("priv-admin"), generation);
+    EXPECT_EQ(cache.find("admin"), nullptr);
+}
+
+TEST(UserInfoCache, ExpiredEntryIsNotReturned)
+{
+    UserInfoCache cache(std::chrono::seconds(0));
+    cache.insert("admin", makeUserInfo("priv-admin"), cache.getGeneration());
+    EXPECT_EQ(cache.find("admin"), nullptr);
+}
+
+TEST(UserInfoCache, HitRatioWithNoLookups)
+{
+    UserInfoCache cache;
+    EXPECT_DOUBLE_EQ(cache.getHitRatio(), 0.0);
+}
+
+} // namespace
+} // namespace crow
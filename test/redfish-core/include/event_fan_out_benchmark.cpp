@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "benchmark.hpp"
+#include "http_body.hpp"
+#include "subscription.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Times sending one event to every push subscriber: building and serializing
+// the payload for each subscriber and copying it into each request, as was
+// done before, against serializing it once and sharing the buffer between
+// the requests.  Run with "meson test --benchmark event_fan_out_benchmark".
+
+namespace
+{
+
+constexpr size_t subscribersCount = 20;
+constexpr size_t eventsCount = 2000;
+
+nlohmann::json makeEvent(uint64_t eventId)
+{
+    nlohmann::json::object_t record;
+    record["EventType"] = "Event";
+    record["EventId"] = std::to_string(eventId);
+    record["EventTimestamp"] = "2024-01-01T00:00:00+00:00";
+    record["MessageId"] = "ResourceEvent.1.0.ResourceChanged";
+    record["Message"] = "One or more resource properties have changed.";
+    record["MessageSeverity"] = "OK";
+    record["OriginOfCondition"] = {
+        {"@odata.id", "/redfish/v1/Systems/system/LogServices/EventLog"}};
+    nlohmann::json::array_t records;
+    records.emplace_back(std::move(record));
+
+    nlohmann::json msg;
+    msg["@odata.type"] = "#Event.v1_4_0.Event";
+    msg["Name"] = "Event Log";
+    msg["Id"] = eventId;
+    msg["Events"] = std::move(records);
+    return msg;
+}
+
+template <typename Func>
+double eventsPerSecond(Func&& func)
+{
+    uint64_t eventId = 0;
+    double seconds = bmcweb::timePerIteration<std::chrono::seconds>(
+        eventsCount, [&]() { func(eventId++); });
+    return 1.0 / seconds;
+}
+
+} // namespace
+
+int main()
+{
+    size_t perSubscriberBytes = 0;
+    double perSubscriber = eventsPerSecond([&](uint64_t eventId) {
+        std::vector<bmcweb::HttpBody::value_type> bodies(subscribersCount);
+        for (bmcweb::HttpBody::value_type& body : bodies)
+        {
+            body.str() = makeEvent(eventId).dump(
+                2, ' ', true, nlohmann::json::error_handler_t::replace);
+        }
+        perSubscriberBytes = bodies.back().strView().size();
+    });
+
+    size_t sharedBytes = 0;
+    double shared = eventsPerSecond([&](uint64_t eventId) {
+        std::shared_ptr<const std::string> payload =
+            redfish::serializeEvent(makeEvent(eventId));
+        std::vector<bmcweb::HttpBody::value_type> bodies(subscribersCount);
+        for (bmcweb::HttpBody::value_type& body : bodies)
+        {
+            body.setSharedStr(payload);
+        }
+        sharedBytes = bodies.back().strView().size();
+    });
+
+    std::printf("%zu push subscribers\n", subscribersCount);
+    std::printf("serialize per subscriber:  %.0f events/s\n", perSubscriber);
+    std::printf("serialize once and share:  %.0f events/s\n", shared);
+    return perSubscriberBytes == sharedBytes ? 0 : 1;
+}
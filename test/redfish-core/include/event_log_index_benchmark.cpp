@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "benchmark.hpp"
+#include "event_log.hpp"
+#include "event_log_index.hpp"
+#include "file_test_utilities.hpp"
+#include "registries.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Times serving one page of the EventLog entry collection from a full set of
+// rotated log files: re-reading and parsing every file, as the handler did
+// before the index, against refreshing the index and reading the page.  Run
+// with "meson test --benchmark event_log_index_benchmark".
+
+namespace
+{
+
+constexpr size_t filesCount = 4;
+constexpr size_t linesPerFile = 5000;
+constexpr size_t pageSize = 50;
+
+void writeLogFiles(const std::filesystem::path& dir)
+{
+    for (size_t fileIndex = 0; fileIndex < filesCount; fileIndex++)
+    {
+        std::string name = "redfish";
+        if (fileIndex > 0)
+        {
+            name += "." + std::to_string(fileIndex);
+        }
+        std::ofstream file(dir / name);
+        for (size_t i = 0; i < linesPerFile; i++)
+        {
+            file << "2024-01-01T00:00:00.000000+00:00 "
+                    "OpenBMC.0.1.PowerButtonPressed,\n";
+        }
+    }
+}
+
+// What every request did before the index: parse the timestamp, for the
+// entry ID, and the message of every line of every file
+size_t scanAllFiles(const std::filesystem::path& dir)
+{
+    size_t valid = 0;
+    std::time_t idSum = 0;
+    for (const std::filesystem::directory_entry& entry :
+         std::filesystem::directory_iterator(dir))
+    {
+        std::ifstream file(entry.path());
+        std::string line;
+        while (std::getline(file, line))
+        {
+            std::tm timeStruct = {};
+            std::istringstream entryStream(line);
+            if (entryStream >> std::get_time(&timeStruct, "%Y-%m-%dT%H:%M:%S"))
+            {
+                idSum += std::mktime(&timeStruct);
+            }
+            std::string timestamp;
+            std::string messageID;
+            std::vector<std::string> messageArgs;
+            if (redfish::event_log::getEventLogParams(
+                    line, timestamp, messageID, messageArgs) == 0 &&
+                redfish::registries::getMessage(messageID) != nullptr)
+            {
+                valid++;
+            }
+        }
+    }
+    return idSum == 0 ? 0 : valid;
+}
+
+} // namespace
+
+int main()
+{
+    TemporaryDirectory tempDir("bmcweb_event_log_benchmark");
+    if (tempDir.path.empty())
+    {
+        return 1;
+    }
+    const std::filesystem::path& dir = tempDir.path;
+    writeLogFiles(dir);
+
+    constexpr size_t iterations = 20;
+    using bmcweb::timePerIteration;
+    using std::chrono::milliseconds;
+    size_t scanned = 0;
+    double scan = timePerIteration<milliseconds>(
+        iterations, [&]() { scanned = scanAllFiles(dir); });
+
+    redfish::event_log::EventLogIndex index(dir);
+    double firstRefresh =
+        timePerIteration<milliseconds>(1, [&]() { index.refresh(); });
+
+    size_t paged = 0;
+    double page = timePerIteration<milliseconds>(iterations, [&]() {
+        index.refresh();
+        paged = index.readEntries(index.getEntryCount() / 2, pageSize).size();
+    });
+
+    std::printf("%zu entries in %zu files\n", scanned, filesCount);
+    std::printf("scan every file:        %.3f ms\n", scan);
+    std::printf("first index refresh:    %.3f ms\n", firstRefresh);
+    std::printf("refresh + page of %zu:  %.3f ms\n", pageSize, page);
+    return scanned == filesCount * linesPerFile && paged == pageSize ? 0 : 1;
+}
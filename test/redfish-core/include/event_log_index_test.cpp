@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "event_log_index.hpp"
+#include "file_test_utilities.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace redfish::event_log
+{
+namespace
+{
+
+using ::testing::ElementsAre;
+using ::testing::Field;
+
+constexpr std::string_view entry1 =
+    "1970-01-01T00:00:01.000000+00:00 OpenBMC.0.1.PowerButtonPressed,";
+constexpr std::string_view entry2 =
+    "1970-01-01T00:00:02.000000+00:00 OpenBMC.0.1.PowerButtonPressed,";
+constexpr std::string_view entry3 =
+    "1970-01-01T00:00:03.000000+00:00 OpenBMC.0.1.PowerButtonPressed,";
+constexpr std::string_view unknownEntry =
+    "1970-01-01T00:00:04.000000+00:00 OpenBMC.0.1.NotARealMessage,";
+
+class EventLogIndexTest : public ::testing::Test
+{
+  protected:
+    void append(const std::string& filename, std::string_view data) const
+    {
+        std::ofstream file(logDir / filename, std::ios::app);
+        file << data;
+    }
+
+    static std::string line(std::string_view entry)
+    {
+        std::string out(entry);
+        out += '\n';
+        return out;
+    }
+
+    TemporaryDirectory tempDir{"bmcweb_event_log_index_test"};
+    std::filesystem::path logDir = tempDir.path;
+};
+
+TEST_F(EventLogIndexTest, PagesAcrossRotatedFiles)
+{
+    append("redfish.1", line(entry1) + line(unknownEntry));
+    append("redfish", line(entry2) + line(entry3));
+
+    EventLogIndex index(logDir);
+    index.refresh();
+    EXPECT_FALSE(index.hasParseErrors());
+    EXPECT_EQ(index.getEntryCount(), 3);
+
+    EXPECT_THAT(index.readEntries(0, 10),
+                ElementsAre(Field(&IndexedLogLine::line, entry1),
+                            Field(&IndexedLogLine::line, entry2),
+                            Field(&IndexedLogLine::line, entry3)));
+    EXPECT_THAT(index.readEntries(1, 1),
+                ElementsAre(Field(&IndexedLogLine::line, entry2)));
+    EXPECT_THAT(index.readEntries(3, 10), ElementsAre());
+}
+
+TEST_F(EventLogIndexTest, IndexesAppendedAndRotatedEntries)
+{
+    append("redfish", line(entry1));
+
+    EventLogIndex index(logDir);
+    index.refresh();
+    EXPECT_EQ(index.getEntryCount(), 1);
+
+    // A partially written line isn't indexed until it is complete
+    append("redfish", entry2);
+    index.refresh();
+    EXPECT_EQ(index.getEntryCount(), 1);
+    append("redfish", "\n");
+    index.refresh();
+    EXPECT_EQ(index.getEntryCount(), 2);
+
+    std::filesystem::rename(logDir / "redfish", logDir / "redfish.1");
+    append("redfish", line(entry3));
+    index.refresh();
+    EXPECT_THAT(index.readEntries(0, 10),
+                ElementsAre(Field(&IndexedLogLine::line, entry1),
+                            Field(&IndexedLogLine::line, entry2),
+                            Field(&IndexedLogLine::line, entry3)));
+
+    std::filesystem::remove(logDir / "redfish.1");
+    index.refresh();
+    EXPECT_THAT(index.readEntries(0, 10),
+                ElementsAre(Field(&IndexedLogLine::line, entry3)));
+}
+
+TEST_F(EventLogIndexTest, IndexesUnterminatedLineOfRotatedFile)
+{
+    append("redfish", line(entry1) + std::string(entry2));
+
+    EventLogIndex index(logDir);
+    index.refresh();
+    EXPECT_EQ(index.getEntryCount(), 1);
+
+    // Once rotated, the file is no longer written to, so its last line is
+    // listed even without a trailing newline
+    std::filesystem::rename(logDir / "redfish", logDir / "redfish.1");
+    append("redfish", line(entry3));
+    index.refresh();
+    EXPECT_THAT(index.readEntries(0, 10),
+                ElementsAre(Field(&IndexedLogLine::line, entry1),
+                            Field(&IndexedLogLine::line, entry2),
+                            Field(&IndexedLogLine::line, entry3)));
+    std::vector<IndexedLogLine> lines = index.readEntries(1, 1);
+    ASSERT_EQ(lines.size(), 1);
+    std::optional<IndexedLogLine> found = index.readEntry(lines[0].id);
+    ASSERT_TRUE(found);
+    EXPECT_EQ(found->line, entry2);
+
+    // A writer that hadn't reopened its file finishes the line late
+    append("redfish.1", "extra\n");
+    index.refresh();
+    EXPECT_EQ(index.getEntryCount(), 3);
+    EXPECT_THAT(index.readEntries(1, 1),
+                ElementsAre(Field(&IndexedLogLine::line,
+                                  std::string(entry2) + "extra")));
+}
+
+TEST_F(EventLogIndexTest, ReadEntryById)
+{
+    append("redfish", line(entry1) + line(entry1) + line(entry2));
+
+    EventLogIndex index(logDir);
+    index.refresh();
+    std::vector<IndexedLogLine> lines = index.readEntries(0, 10);
+    ASSERT_EQ(lines.size(), 3);
+    EXPECT_EQ(lines[1].id, lines[0].id + "_1");
+
+    for (const IndexedLogLine& expected : lines)
+    {
+        std::optional<IndexedLogLine> found = index.readEntry(expected.id);
+        ASSERT_TRUE(found);
+        EXPECT_EQ(found->id, expected.id);
+        EXPECT_EQ(found->line, expected.line);
+    }
+
+    EXPECT_FALSE(index.readEntry(lines[0].id + "_2"));
+    EXPECT_FALSE(index.readEntry("notanid"));
+    EXPECT_FALSE(index.readEntry(lines[0].id + "_0"));
+    // Only the canonical spelling of an ID names the entry
+    EXPECT_FALSE(index.readEntry("0" + lines[0].id));
+    EXPECT_FALSE(index.readEntry(lines[0].id + "_01"));
+}
+
+TEST_F(EventLogIndexTest, ReadEntryAfterAppend)
+{
+    append("redfish", line(entry2));
+
+    EventLogIndex index(logDir);
+    index.refresh();
+    std::vector<IndexedLogLine> lines = index.readEntries(0, 10);
+    ASSERT_EQ(lines.size(), 1);
+    ASSERT_TRUE(index.readEntry(lines[0].id));
+
+    // Appended entries are added to the ID index without rebuilding it,
+    // including one older than the last, as after the clock was set back
+    append("redfish", line(entry3) + line(entry1));
+    index.refresh();
+    lines = index.readEntries(0, 10);
+    ASSERT_EQ(lines.size(), 3);
+    for (const IndexedLogLine& expected : lines)
+    {
+        std::optional<IndexedLogLine> found = index.readEntry(expected.id);
+        ASSERT_TRUE(found);
+        EXPECT_EQ(found->line, expected.line);
+    }
+}
+
+TEST_F(EventLogIndexTest, ParseErrors)
+{
+    append("redfish", line(entry1) + line("garbage"));
+
+    EventLogIndex index(logDir);
+    index.refresh();
+    EXPECT_TRUE(index.hasParseErrors());
+}
+
+} // namespace
+} // namespace redfish::event_log
@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "event_replay_log.hpp"
+#include "file_test_utilities.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace redfish
+{
+namespace
+{
+
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+class EventReplayLogTest : public ::testing::Test
+{
+  protected:
+    static std::vector<std::pair<uint64_t, std::string>> readAll(
+        const EventReplayLog& log, uint64_t afterId, uint64_t endId = 1000,
+        size_t maxBytes = 1000000)
+    {
+        std::vector<std::pair<uint64_t, std::string>> events;
+        log.read(afterId, endId, maxBytes,
+                 [&events](uint64_t id, std::string_view payload) {
+                     events.emplace_back(id, payload);
+                 });
+        return events;
+    }
+
+    TemporaryDirectory tempDir{"bmcweb_event_replay_log_test"};
+    std::filesystem::path dir = tempDir.path;
+};
+
+TEST_F(EventReplayLogTest, ReadsAfterId)
+{
+    EventReplayLog log(dir, 1000000);
+    EXPECT_EQ(log.getLastId(), 0);
+    log.append(2, "two");
+    log.append(5, "five");
+    log.append(6, "six");
+    EXPECT_EQ(log.getLastId(), 6);
+    EXPECT_TRUE(log.hasEvent(5));
+    EXPECT_FALSE(log.hasEvent(4));
+
+    EXPECT_THAT(readAll(log, 2), ElementsAre(Pair(5, "five"), Pair(6, "six")));
+    EXPECT_THAT(readAll(log, 2, 5), ElementsAre(Pair(5, "five")));
+    EXPECT_THAT(readAll(log, 6), ElementsAre());
+
+    // Stops once the byte limit is reached
+    std::vector<std::pair<uint64_t, std::string>> events;
+    uint64_t last = log.read(0, 1000, 1,
+                             [&events](uint64_t id, std::string_view payload) {
+                                 events.emplace_back(id, payload);
+                             });
+    EXPECT_EQ(last, 2);
+    EXPECT_THAT(events, ElementsAre(Pair(2, "two")));
+
+    // Older events are refused
+    log.append(4, "four");
+    EXPECT_FALSE(log.hasEvent(4));
+}
+
+TEST_F(EventReplayLogTest, SurvivesRestart)
+{
+    {
+        EventReplayLog log(dir, 1000000);
+        log.append(1, "one");
+        log.append(2, "two");
+    }
+    EventReplayLog log(dir, 1000000);
+    EXPECT_EQ(log.getLastId(), 2);
+    log.append(3, "three");
+    EXPECT_THAT(readAll(log, 0), ElementsAre(Pair(1, "one"), Pair(2, "two"),
+                                             Pair(3, "three")));
+}
+
+TEST_F(EventReplayLogTest, DropsOldestSegments)
+{
+    // Segments are at least 4KiB, so this keeps about three of them
+    EventReplayLog log(dir, 16384);
+    std::string payload(1000, 'x');
+    for (uint64_t id = 1; id <= 100; id++)
+    {
+        log.append(id, payload);
+    }
+    EXPECT_EQ(log.getLastId(), 100);
+    EXPECT_FALSE(log.hasEvent(1));
+    EXPECT_TRUE(log.hasEvent(99));
+
+    std::vector<std::pair<uint64_t, std::string>> events = readAll(log, 0);
+    ASSERT_FALSE(events.empty());
+    EXPECT_LT(events.size(), 20);
+    EXPECT_EQ(events.back().first, 100);
+
+    uint64_t total = 0;
+    for (const std::filesystem::directory_entry& entry :
+         std::filesystem::directory_iterator(dir))
+    {
+        total += entry.file_size();
+    }
+    EXPECT_LE(total, 16384);
+}
+
+TEST_F(EventReplayLogTest, TruncatesTornRecord)
+{
+    {
+        EventReplayLog log(dir, 1000000);
+        log.append(1, "one");
+        log.append(2, "two");
+    }
+    std::filesystem::path segment = dir / std::format("{:020}", 1);
+    std::filesystem::resize_file(segment,
+                                 std::filesystem::file_size(segment) - 1);
+
+    EventReplayLog log(dir, 1000000);
+    EXPECT_EQ(log.getLastId(), 1);
+    log.append(2, "TWO");
+    EXPECT_THAT(readAll(log, 0), ElementsAre(Pair(1, "one"), Pair(2, "TWO")));
+}
+
+} // namespace
+} // namespace redfish
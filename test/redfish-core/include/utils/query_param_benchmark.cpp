@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "benchmark.hpp"
+#include "utils/query_param.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Times finding the navigation references to $expand in a large expanded
+// collection, and reaching each one to place its response: the walk as it was
+// before, which built a json_pointer for every node it visited and resolved
+// each pointer from the root, against the current walk, which records where
+// each reference lives.  Run with "meson test --benchmark
+// query_param_benchmark".
+
+namespace
+{
+
+constexpr size_t membersCount = 500;
+constexpr size_t propertiesCount = 20;
+constexpr size_t referencesCount = 5;
+
+nlohmann::json makeCollection()
+{
+    nlohmann::json::array_t members;
+    for (size_t i = 0; i < membersCount; i++)
+    {
+        std::string uri = "/redfish/v1/Chassis/chassis" + std::to_string(i);
+        nlohmann::json::object_t member;
+        member["@odata.id"] = uri;
+        for (size_t prop = 0; prop < propertiesCount; prop++)
+        {
+            member["Property" + std::to_string(prop)] = "value";
+        }
+        nlohmann::json::object_t status;
+        status["State"] = "Enabled";
+        status["Health"] = "OK";
+        member["Status"] = std::move(status);
+        for (size_t ref = 0; ref < referencesCount; ref++)
+        {
+            nlohmann::json::object_t reference;
+            reference["@odata.id"] = uri + "/Resource" + std::to_string(ref);
+            member["Resource" + std::to_string(ref)] = std::move(reference);
+        }
+        members.emplace_back(std::move(member));
+    }
+    nlohmann::json collection;
+    collection["@odata.id"] = "/redfish/v1/Chassis";
+    collection["Members@odata.count"] = membersCount;
+    collection["Members"] = std::move(members);
+    return collection;
+}
+
+// The walk as it was before, for ExpandType::Both, which never needs to look
+// at "Links"
+struct PointerNode
+{
+    nlohmann::json::json_pointer location;
+    std::string uri;
+};
+
+void findByPointer(nlohmann::json& json,
+                   const nlohmann::json::json_pointer& jsonPtr, int depth,
+                   int skipDepth, std::vector<PointerNode>& out)
+{
+    nlohmann::json::array_t* array = json.get_ptr<nlohmann::json::array_t*>();
+    if (array != nullptr)
+    {
+        size_t index = 0;
+        for (nlohmann::json& element : *array)
+        {
+            findByPointer(element, jsonPtr / index, depth, skipDepth, out);
+            index++;
+        }
+    }
+    nlohmann::json::object_t* obj = json.get_ptr<nlohmann::json::object_t*>();
+    if (obj == nullptr)
+    {
+        return;
+    }
+    if (obj->size() == 1 && obj->begin()->first == "@odata.id")
+    {
+        const std::string* uri =
+            obj->begin()->second.get_ptr<const std::string*>();
+        if (uri != nullptr)
+        {
+            if (skipDepth == 0)
+            {
+                out.push_back({jsonPtr, *uri});
+            }
+            return;
+        }
+    }
+    int newDepth = depth;
+    if (obj->contains("@odata.id"))
+    {
+        if (obj->size() > 1)
+        {
+            if (depth == 0)
+            {
+                return;
+            }
+            if (skipDepth > 0)
+            {
+                skipDepth--;
+            }
+        }
+        if (skipDepth == 0)
+        {
+            newDepth--;
+        }
+    }
+    for (auto& element : *obj)
+    {
+        findByPointer(element.second, jsonPtr / element.first, newDepth,
+                      skipDepth, out);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    nlohmann::json collection = makeCollection();
+    constexpr int depth = 2;
+    constexpr size_t iterations = 50;
+    using bmcweb::timePerIteration;
+    using std::chrono::microseconds;
+
+    size_t pointerFound = 0;
+    size_t pointerReached = 0;
+    double pointerWalk = timePerIteration<microseconds>(iterations, [&]() {
+        std::vector<PointerNode> nodes;
+        // The root is skipped, as findNavigationReferences() does
+        findByPointer(collection, nlohmann::json::json_pointer(""), depth, 1,
+                      nodes);
+        pointerFound = nodes.size();
+        pointerReached = 0;
+        for (const PointerNode& node : nodes)
+        {
+            pointerReached += collection[node.location].size();
+        }
+    });
+
+    size_t found = 0;
+    size_t reached = 0;
+    double walk = timePerIteration<microseconds>(iterations, [&]() {
+        std::vector<redfish::query_param::ExpandNode> nodes =
+            redfish::query_param::findNavigationReferences(
+                redfish::query_param::ExpandType::Both, depth, 0, collection);
+        found = nodes.size();
+        reached = 0;
+        for (const redfish::query_param::ExpandNode& node : nodes)
+        {
+            reached += node.location->size();
+        }
+    });
+
+    std::printf("%zu references in %zu members\n", found, membersCount);
+    std::printf("json_pointer walk:  %.1f us\n", pointerWalk);
+    std::printf("location walk:      %.1f us\n", walk);
+    return found == membersCount * referencesCount && found == pointerFound &&
+                   reached == pointerReached
+               ? 0
+               : 1;
+}
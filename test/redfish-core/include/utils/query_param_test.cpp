@@ -27,6 +27,12 @@ namespace
 
 using ::testing::UnorderedElementsAre;
 
+ExpandNode expandNodeAt(nlohmann::json& root, const char* pointer,
+                        std::string uri)
+{
+    return {&root.at(nlohmann::json::json_pointer(pointer)), std::move(uri)};
+}
+
 TEST(Delegate, OnlyPositive)
 {
     Query query{
@@ -585,14 +591,12 @@ TEST(QueryParams, FindNavigationReferencesNonLink)
     // Parsing as the root should net one entry
     EXPECT_THAT(
         findNavigationReferences(ExpandType::Both, 1, 0, singleTreeNode),
-        UnorderedElementsAre(
-            ExpandNode{json::json_pointer("/Foo"), "/foobar"}));
+        UnorderedElementsAre(expandNodeAt(singleTreeNode, "/Foo", "/foobar")));
 
     // Parsing in Non-hyperlinks mode should net one entry
     EXPECT_THAT(
         findNavigationReferences(ExpandType::NotLinks, 1, 0, singleTreeNode),
-        UnorderedElementsAre(
-            ExpandNode{json::json_pointer("/Foo"), "/foobar"}));
+        UnorderedElementsAre(expandNodeAt(singleTreeNode, "/Foo", "/foobar")));
 
     // Searching for not types should return empty set
     EXPECT_TRUE(findNavigationReferences(ExpandType::None, 1, 0, singleTreeNode)
@@ -613,8 +617,7 @@ TEST(QueryParams, FindNavigationReferencesNonLink)
     // Should still find Foo
     EXPECT_THAT(
         findNavigationReferences(ExpandType::NotLinks, 1, 0, multiTreeNodes),
-        UnorderedElementsAre(
-            ExpandNode{json::json_pointer("/Foo"), "/foobar"}));
+        UnorderedElementsAre(expandNodeAt(multiTreeNodes, "/Foo", "/foobar")));
 }
 
 TEST(QueryParams, FindNavigationReferencesLink)
@@ -631,12 +634,12 @@ TEST(QueryParams, FindNavigationReferencesLink)
     EXPECT_THAT(
         findNavigationReferences(ExpandType::Both, 1, 0, singleLinkNode),
         UnorderedElementsAre(
-            ExpandNode{json::json_pointer("/Links/Sessions"), "/foobar"}));
+            expandNodeAt(singleLinkNode, "/Links/Sessions", "/foobar")));
     // Parsing in hyperlinks mode should net one entry
     EXPECT_THAT(
         findNavigationReferences(ExpandType::Links, 1, 0, singleLinkNode),
         UnorderedElementsAre(
-            ExpandNode{json::json_pointer("/Links/Sessions"), "/foobar"}));
+            expandNodeAt(singleLinkNode, "/Links/Sessions", "/foobar")));
 
     // Searching for not types should return empty set
     EXPECT_TRUE(findNavigationReferences(ExpandType::None, 1, 0, singleLinkNode)
@@ -687,10 +690,10 @@ TEST(QueryParams, PreviouslyExpanded)
     // Previous expand was only a single level so we should further expand
     EXPECT_THAT(findNavigationReferences(ExpandType::NotLinks, 2, 0, expNode),
                 UnorderedElementsAre(
-                    ExpandNode{json::json_pointer("/Members/0/Sensors"),
-                               "/redfish/v1/Chassis/5B247A_Sat1/Sensors"},
-                    ExpandNode{json::json_pointer("/Members/1/Sensors"),
-                               "/redfish/v1/Chassis/5B247A_Sat2/Sensors"}));
+                    expandNodeAt(expNode, "/Members/0/Sensors",
+                                 "/redfish/v1/Chassis/5B247A_Sat1/Sensors"),
+                    expandNodeAt(expNode, "/Members/1/Sensors",
+                                 "/redfish/v1/Chassis/5B247A_Sat2/Sensors")));
 
     // Make sure we can handle when an array was expanded further down the tree
     json expNode2 = R"({"@odata.id" : "/redfish/v1"})"_json;
@@ -703,10 +706,10 @@ TEST(QueryParams, PreviouslyExpanded)
     // Previous expand was two levels so we should further expand
     EXPECT_THAT(findNavigationReferences(ExpandType::NotLinks, 3, 0, expNode2),
                 UnorderedElementsAre(
-                    ExpandNode{json::json_pointer("/Chassis/Members/0/Sensors"),
-                               "/redfish/v1/Chassis/5B247A_Sat1/Sensors"},
-                    ExpandNode{json::json_pointer("/Chassis/Members/1/Sensors"),
-                               "/redfish/v1/Chassis/5B247A_Sat2/Sensors"}));
+                    expandNodeAt(expNode2, "/Chassis/Members/0/Sensors",
+                                 "/redfish/v1/Chassis/5B247A_Sat1/Sensors"),
+                    expandNodeAt(expNode2, "/Chassis/Members/1/Sensors",
+                                 "/redfish/v1/Chassis/5B247A_Sat2/Sensors")));
 }
 
 TEST(QueryParams, DelegatedSkipExpanded)
@@ -733,13 +736,13 @@ TEST(QueryParams, DelegatedSkipExpanded)
 
     EXPECT_THAT(findNavigationReferences(ExpandType::NotLinks, 2, 0, expNode),
                 UnorderedElementsAre(
-                    ExpandNode{json::json_pointer("/Foo"), "/foo"},
-                    ExpandNode{json::json_pointer("/Bar/Foo"), "/barfoo"}));
+                    expandNodeAt(expNode, "/Foo", "/foo"),
+                    expandNodeAt(expNode, "/Bar/Foo", "/barfoo")));
 
     // Skip the first expand level
     EXPECT_THAT(findNavigationReferences(ExpandType::NotLinks, 1, 1, expNode),
                 UnorderedElementsAre(
-                    ExpandNode{json::json_pointer("/Bar/Foo"), "/barfoo"}));
+                    expandNodeAt(expNode, "/Bar/Foo", "/barfoo")));
 }
 
 TEST(QueryParams, PartiallyPreviouslyExpanded)
@@ -774,17 +777,17 @@ TEST(QueryParams, PartiallyPreviouslyExpanded)
     // only want to expand the Local Chassis
     EXPECT_THAT(
         findNavigationReferences(ExpandType::NotLinks, 1, 0, expNode),
-        UnorderedElementsAre(ExpandNode{json::json_pointer("/Members/0"),
-                                        "/redfish/v1/Chassis/Local"}));
+        UnorderedElementsAre(expandNodeAt(expNode, "/Members/0",
+                                          "/redfish/v1/Chassis/Local")));
 
     // The 5B247A_Sat1 Chassis was already expanded a single level so we should
     // further expand it as well as the Local Chassis
     EXPECT_THAT(findNavigationReferences(ExpandType::NotLinks, 2, 0, expNode),
                 UnorderedElementsAre(
-                    ExpandNode{json::json_pointer("/Members/0"),
-                               "/redfish/v1/Chassis/Local"},
-                    ExpandNode{json::json_pointer("/Members/1/Sensors"),
-                               "/redfish/v1/Chassis/5B247A_Sat1/Sensors"}));
+                    expandNodeAt(expNode, "/Members/0",
+                                 "/redfish/v1/Chassis/Local"),
+                    expandNodeAt(expNode, "/Members/1/Sensors",
+                                 "/redfish/v1/Chassis/5B247A_Sat1/Sensors")));
 
     // Now the response has paths that have been expanded 0, 1, and 2 times
     json expNode2 = R"({"@odata.id" : "/redfish/v1",
@@ -792,24 +795,24 @@ TEST(QueryParams, PartiallyPreviouslyExpanded)
     expNode2["Chassis"] = std::move(expNode);
 
     EXPECT_THAT(findNavigationReferences(ExpandType::NotLinks, 1, 0, expNode2),
-                UnorderedElementsAre(ExpandNode{json::json_pointer("/Systems"),
-                                                "/redfish/v1/Systems"}));
+                UnorderedElementsAre(expandNodeAt(expNode2, "/Systems",
+                                                  "/redfish/v1/Systems")));
 
     EXPECT_THAT(
         findNavigationReferences(ExpandType::NotLinks, 2, 0, expNode2),
         UnorderedElementsAre(
-            ExpandNode{json::json_pointer("/Systems"), "/redfish/v1/Systems"},
-            ExpandNode{json::json_pointer("/Chassis/Members/0"),
-                       "/redfish/v1/Chassis/Local"}));
+            expandNodeAt(expNode2, "/Systems", "/redfish/v1/Systems"),
+            expandNodeAt(expNode2, "/Chassis/Members/0",
+                         "/redfish/v1/Chassis/Local")));
 
     EXPECT_THAT(
         findNavigationReferences(ExpandType::NotLinks, 3, 0, expNode2),
         UnorderedElementsAre(
-            ExpandNode{json::json_pointer("/Systems"), "/redfish/v1/Systems"},
-            ExpandNode{json::json_pointer("/Chassis/Members/0"),
-                       "/redfish/v1/Chassis/Local"},
-            ExpandNode{json::json_pointer("/Chassis/Members/1/Sensors"),
-                       "/redfish/v1/Chassis/5B247A_Sat1/Sensors"}));
+            expandNodeAt(expNode2, "/Systems", "/redfish/v1/Systems"),
+            expandNodeAt(expNode2, "/Chassis/Members/0",
+                         "/redfish/v1/Chassis/Local"),
+            expandNodeAt(expNode2, "/Chassis/Members/1/Sensors",
+                         "/redfish/v1/Chassis/5B247A_Sat1/Sensors")));
 }
 
 } // namespace
@@ -5,6 +5,9 @@
 
 #include <filesystem>
 #include <format>
+#include <fstream>
+#include <optional>
+#include <string>
 #include <string_view>
 
 #include <gtest/gtest.h>
@@ -51,5 +54,42 @@ TEST(MetadataGet, GetOneFile)
     EXPECT_EQ(getMetadataPieceForFile("DoesNotExist_v1.xml"), "");
 }
 
+TEST(MetadataGet, BuildFromDirectory)
+{
+    std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / "bmcweb_metadata_test";
+    std::filesystem::create_directories(dir);
+    {
+        std::ofstream out(dir / "MyNewNamespace_v1.xml");
+        out << content;
+    }
+    {
+        std::ofstream out(dir / "Ignored.json");
+        out << "{}";
+    }
+
+    std::optional<std::string> xml = buildMetadata(dir);
+    std::filesystem::remove_all(dir);
+    ASSERT_TRUE(xml);
+    EXPECT_NE(xml->find("<edmx:Reference "
+                        "Uri=\"/redfish/v1/schema/MyNewNamespace_v1.xml\">"),
+              std::string::npos);
+    EXPECT_EQ(xml->find("Ignored"), std::string::npos);
+
+    EXPECT_FALSE(buildMetadata(dir));
+}
+
+TEST(MetadataGet, CachedDocumentEtag)
+{
+    CachedDocument first = makeCachedDocument("body");
+    CachedDocument second = makeCachedDocument("body");
+    CachedDocument other = makeCachedDocument("other");
+    ASSERT_NE(first.body, nullptr);
+    EXPECT_EQ(*first.body, "body");
+    EXPECT_FALSE(first.etag.empty());
+    EXPECT_EQ(first.etag, second.etag);
+    EXPECT_NE(first.etag, other.etag);
+}
+
 } // namespace
 } // namespace redfish